@@ -0,0 +1,129 @@
+// Merenje skaliranja prepravljanja relokacija linkera sa brojem niti na sintetickim ulazima.
+// upotreba: linker_bench [broj_objektnih_fajlova] [relokacija_po_fajlu] [maksimalan_broj_niti]
+
+#include <linker/linker.hpp>
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace lnk_core;
+using namespace common;
+
+namespace
+{
+constexpr uint32_t DEFAULT_NUM_OBJECTS = 64;
+constexpr uint32_t DEFAULT_RELOCATIONS_PER_OBJECT = 32768;
+
+// objekat k: sekcija text sa relokacijama naizmenicno na globalni simbol iz objekta k + 1 i na lokalnu sekciju data
+AssemblerOutputData makeObject(uint32_t index, uint32_t numObjects, uint32_t numRelocations)
+{
+  constexpr uint32_t TEXT = 1, DATA = 2, EXTERN_SYMBOL = 4;
+  uint32_t dataSize = 4 * (numRelocations / 4 + 1);
+
+  AssemblerOutputData data;
+  data.symbolTable.emplace_back("UND", 0, -1, false, false, false, 0);
+  data.symbolTable.emplace_back("text", TEXT, 0, false, false, false, 4 * numRelocations);
+  data.symbolTable.emplace_back("data", DATA, 0, false, false, false, dataSize);
+  data.symbolTable.emplace_back("sym_" + std::to_string(index), TEXT, 0, true, false, true, 0);
+  data.symbolTable.emplace_back("sym_" + std::to_string((index + 1) % numObjects), 0, 0, true, true, false, 0);
+  data.sectionOrder = {"text", "data"};
+
+  SectionMemory& text = data.sectionMemoryMap[TEXT];
+  std::vector<RelocationEntry>& relocations = data.sectionRelocationMap[TEXT];
+  relocations.reserve(numRelocations);
+  for(uint32_t i = 0; i < numRelocations; ++i)
+  {
+    text.writeWord(i % 4 * 4);
+    relocations.emplace_back(OperationCodes::LD_REG_MEM_DIR, 4 * i, i % 2 == 0 ? EXTERN_SYMBOL : DATA);
+  }
+  data.sectionMemoryMap[DATA].writeBSS(dataSize);
+
+  return data;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string readFile(const std::string& filePath)
+{
+  std::ifstream inFile(filePath);
+  std::stringstream buffer;
+  buffer << inFile.rdbuf();
+  return buffer.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  uint32_t numObjects = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : DEFAULT_NUM_OBJECTS;
+  uint32_t numRelocations = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : DEFAULT_RELOCATIONS_PER_OBJECT;
+  uint32_t maxThreads = argc > 3 ? std::strtoul(argv[3], nullptr, 0) : std::thread::hardware_concurrency();
+  maxThreads = std::max(maxThreads, 1U);
+
+  try
+  {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "linker_bench";
+    std::filesystem::create_directories(directory);
+
+    std::vector<std::string> inputFilePaths;
+    for(uint32_t i = 0; i < numObjects; ++i)
+    {
+      inputFilePaths.push_back((directory / ("input" + std::to_string(i) + ".o")).string());
+      ObjectFileProcessor::writeToFile(makeObject(i, numObjects, numRelocations), inputFilePaths.back());
+    }
+    std::cout << "Objektni fajlovi: " << numObjects << ", relokacija: "
+              << static_cast<uint64_t>(numObjects) * numRelocations << "\n";
+    std::cout << std::left << std::setw(8) << "Niti" << std::right << std::setw(16) << "Relokacije (us)"
+              << std::setw(10) << "Ubrzanje" << "\n";
+
+    std::string referenceOutput;
+    uint64_t singleThreadTime = 0;
+    for(uint32_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+      std::string outputFilePath = (directory / "output.hex").string();
+      LinkerOptions options;
+      options.numThreads = numThreads;
+      Linker linker({{"text", 0x40000000, ""}}, inputFilePaths, outputFilePath, options);
+
+      std::ostringstream linkerLog;
+      std::streambuf* coutBuffer = std::cout.rdbuf(linkerLog.rdbuf());
+      linker.performLinking();
+      std::cout.rdbuf(coutBuffer);
+
+      uint64_t patchTime = 0;
+      for(const PhaseTime& phaseTime : linker.getPhaseTimes())
+      {
+        if(phaseTime.name == "relokacije")
+        {
+          patchTime = phaseTime.microseconds;
+        }
+      }
+      if(numThreads == 1)
+      {
+        singleThreadTime = patchTime;
+        referenceOutput = readFile(outputFilePath);
+      }
+      else if(readFile(outputFilePath) != referenceOutput)
+      {
+        throw RuntimeError("Izlaz sa " + std::to_string(numThreads) + " niti se razlikuje od izlaza sa jednom niti!");
+      }
+
+      std::cout << std::dec << std::left << std::setw(8) << numThreads << std::right << std::setw(16) << patchTime
+                << std::setw(9) << std::fixed << std::setprecision(2)
+                << (patchTime == 0 ? 0.0 : static_cast<double>(singleThreadTime) / patchTime) << "x\n";
+    }
+
+    std::filesystem::remove_all(directory);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return -1;
+  }
+}
@@ -0,0 +1,232 @@
+// Poredjenje citaca tekstualnog objektnog formata sa ranijim citacem (istringstream po redu, std::stoul po bajtu)
+// na sintetickim objektnim fajlovima od nekoliko megabajta.
+// upotreba: object_reader_bench [bajtova_koda_u_MB] [broj_ponavljanja]
+
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace lnk_core;
+using namespace common;
+
+namespace
+{
+constexpr uint32_t DEFAULT_CODE_MEGABYTES = 4;
+constexpr uint32_t DEFAULT_NUM_REPETITIONS = 5;
+constexpr uint32_t NUM_SYMBOLS = 4096;
+
+// sekcija text sa kodom i bazenom, relokacija na svaku osmu rec, i tabela simbola sa lokalnim i globalnim simbolima
+AssemblerOutputData makeObject(uint32_t codeSize)
+{
+  constexpr uint32_t TEXT = 1, DATA = 2;
+  uint32_t numWords = codeSize / 4;
+
+  AssemblerOutputData data;
+  data.symbolTable.emplace_back("UND", 0, -1, false, false, false, 0);
+  data.symbolTable.emplace_back("text", TEXT, 0, false, false, false, 4 * numWords);
+  data.symbolTable.emplace_back("data", DATA, 0, false, false, false, 4 * NUM_SYMBOLS);
+  for(uint32_t i = 0; i < NUM_SYMBOLS; ++i)
+  {
+    data.symbolTable.emplace_back("symbol_" + std::to_string(i), i % 2 == 0 ? TEXT : DATA, 4 * i,
+                                  i % 3 == 0, false, true, UINT32_MAX);
+  }
+  data.sectionOrder = {"text", "data"};
+
+  SectionMemory& text = data.sectionMemoryMap[TEXT];
+  std::vector<RelocationEntry>& relocations = data.sectionRelocationMap[TEXT];
+  for(uint32_t i = 0; i < numWords; ++i)
+  {
+    if(i % 8 == 0)
+    {
+      text.writeLiteral(i * 2654435761U);
+      relocations.emplace_back(OperationCodes::WORD, 4 * i, 3 + i % NUM_SYMBOLS);
+    }
+    text.writeWord(i * 2246822519U);
+  }
+  data.sectionMemoryMap[DATA].writeBSS(4 * NUM_SYMBOLS);
+
+  return data;
+}
+
+// raniji citac, zadrzan samo radi poredjenja
+namespace legacy
+{
+
+std::vector<std::string> splitLine(const std::string& line)
+{
+  std::istringstream lineStream(line);
+  std::string token;
+  std::vector<std::string> tokens;
+  while(std::getline(lineStream, token, ':'))
+  {
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+//-----------------------------------------------------------------------------------------------------------
+LinkerInputData readFromFile(const std::string& filePath)
+{
+  enum class ReadMode { SYMBOL_TABLE, RELOCATION_TABLE, GENERATED_CODE };
+
+  std::ifstream inFile(filePath);
+  LinkerInputData data;
+  std::string line;
+  ReadMode readMode = ReadMode::SYMBOL_TABLE;
+  uint32_t sectionNumber = 0;
+  while(std::getline(inFile, line))
+  {
+    if(line.find("Sym:") != std::string::npos)
+    {
+      readMode = ReadMode::SYMBOL_TABLE;
+      continue;
+    }
+    else if(line.find("Rel:") != std::string::npos || line.find("Code:") != std::string::npos)
+    {
+      readMode = line[0] == 'R' ? ReadMode::RELOCATION_TABLE : ReadMode::GENERATED_CODE;
+      sectionNumber = std::stoul(line.substr(line.find(':') + 1));
+      continue;
+    }
+
+    switch(readMode)
+    {
+      case ReadMode::SYMBOL_TABLE:
+      {
+        std::vector<std::string> tokens = splitLine(line);
+        data.symbolTable.emplace_back(tokens[0], std::stoul(tokens[1]), std::stoi(tokens[2]), tokens[3] == "1",
+                                      tokens[4] == "1", tokens[5] == "1", std::stoul(tokens[6]));
+        break;
+      }
+      case ReadMode::RELOCATION_TABLE:
+      {
+        std::vector<std::string> tokens = splitLine(line);
+        data.sectionRelocationMap[sectionNumber].emplace_back(
+          static_cast<OperationCodes>(std::stoi(tokens[0])), std::stoul(tokens[1]), std::stoul(tokens[2]));
+        break;
+      }
+      case ReadMode::GENERATED_CODE:
+      {
+        std::istringstream lineStream(line);
+        std::string token;
+        std::vector<uint8_t> sectionData;
+        while(lineStream >> token)
+        {
+          sectionData.push_back(static_cast<uint8_t>(std::stoul(token)));
+        }
+        data.sectionMemoryMap[sectionNumber] = sectionData;
+        break;
+      }
+    }
+  }
+
+  return data;
+}
+
+} // namespace legacy
+
+bool isSameData(const LinkerInputData& data1, const LinkerInputData& data2)
+{
+  if(data1.symbolTable.size() != data2.symbolTable.size() || data1.sectionMemoryMap != data2.sectionMemoryMap ||
+     data1.sectionRelocationMap.size() != data2.sectionRelocationMap.size())
+  {
+    return false;
+  }
+
+  for(uint32_t i = 0, tableSize = data1.symbolTable.size(); i < tableSize; ++i)
+  {
+    const Symbol& symbol1 = data1.symbolTable[i];
+    const Symbol& symbol2 = data2.symbolTable[i];
+    if(symbol1.name != symbol2.name || symbol1.sectionNumber != symbol2.sectionNumber ||
+       symbol1.value != symbol2.value || symbol1.isGlobal != symbol2.isGlobal ||
+       symbol1.isExtern != symbol2.isExtern || symbol1.isDefined != symbol2.isDefined || symbol1.size != symbol2.size)
+    {
+      return false;
+    }
+  }
+
+  for(const auto& [sectionNumber, relocations1] : data1.sectionRelocationMap)
+  {
+    auto relocationIter = data2.sectionRelocationMap.find(sectionNumber);
+    if(relocationIter == data2.sectionRelocationMap.end() ||
+       !std::equal(relocations1.begin(), relocations1.end(), relocationIter->second.begin(), relocationIter->second.end(),
+                   [](const RelocationEntry& entry1, const RelocationEntry& entry2)
+                   {
+                     return entry1.operationCode == entry2.operationCode && entry1.offset == entry2.offset &&
+                            entry1.symbolTableReference == entry2.symbolTableReference;
+                   }))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+// najbolje vreme od vise ponavljanja, u mikrosekundama
+template<typename ReadFunction>
+uint64_t measure(uint32_t numRepetitions, ReadFunction readFunction)
+{
+  uint64_t bestTime = UINT64_MAX;
+  for(uint32_t i = 0; i < numRepetitions; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    readFunction();
+    uint64_t time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    bestTime = std::min(bestTime, time);
+  }
+  return bestTime;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  uint32_t codeMegabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : DEFAULT_CODE_MEGABYTES;
+  uint32_t numRepetitions = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : DEFAULT_NUM_REPETITIONS;
+  numRepetitions = std::max(numRepetitions, 1U);
+
+  try
+  {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "object_reader_bench";
+    std::filesystem::create_directories(directory);
+    std::string objectFilePath = (directory / "input.o").string();
+    ObjectFileProcessor::writeToFile(makeObject(codeMegabytes * 1024 * 1024), objectFilePath);
+    uint64_t fileSize = std::filesystem::file_size(objectFilePath);
+
+    if(!isSameData(legacy::readFromFile(objectFilePath), ObjectFileProcessor::readFromFile(objectFilePath)))
+    {
+      throw RuntimeError("Citaci objektnog fajla daju razlicite rezultate!");
+    }
+
+    uint64_t legacyTime = measure(numRepetitions, [&objectFilePath]() { legacy::readFromFile(objectFilePath); });
+    uint64_t readerTime = measure(numRepetitions, [&objectFilePath]() { ObjectFileProcessor::readFromFile(objectFilePath); });
+
+    auto toMegabytesPerSecond = [fileSize](uint64_t microseconds)
+    {
+      return microseconds == 0 ? 0.0 : static_cast<double>(fileSize) / microseconds;
+    };
+    std::cout << "Objektni fajl: " << fileSize << " bajtova\n";
+    std::cout << std::left << std::setw(10) << "Citac" << std::right << std::setw(12) << "Vreme (us)"
+              << std::setw(10) << "MB/s" << "\n";
+    std::cout << std::fixed << std::setprecision(2)
+              << std::left << std::setw(10) << "raniji" << std::right << std::setw(12) << legacyTime
+              << std::setw(10) << toMegabytesPerSecond(legacyTime) << "\n"
+              << std::left << std::setw(10) << "novi" << std::right << std::setw(12) << readerTime
+              << std::setw(10) << toMegabytesPerSecond(readerTime) << "\n"
+              << "Ubrzanje: " << (readerTime == 0 ? 0.0 : static_cast<double>(legacyTime) / readerTime) << "x\n";
+
+    std::filesystem::remove_all(directory);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return -1;
+  }
+}
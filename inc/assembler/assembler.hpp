@@ -1,15 +1,17 @@
 #pragma once
 
+#include <common/arena.hpp>
 #include <common/assembler_common_structures.hpp>
 
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 #include <unordered_map>
 
 using namespace common;
 
-using ParameterType = std::variant<std::string, uint32_t, uint8_t, uint16_t>;
+using ParameterType = std::variant<std::string_view, uint32_t, uint8_t, uint16_t>; // imena su iz bazena asemblera
 using Parameters = std::vector<ParameterType>;
 
 namespace asm_core
@@ -20,14 +22,15 @@ namespace asm_core
 class Assembler
 {
 public:
+  // bez izlaznog fajla (prazan outputFilePath) rezultat ostaje samo u getOutputData
   Assembler(const std::string& outputFilePath);
-  void insertGlobalSymbol(const std::string& symbolName);
-  void insertExternSymbol(const std::string& symbolName);
-  void defineSymbol(const std::string& symbolName);
+  void insertGlobalSymbol(std::string_view symbolName);
+  void insertExternSymbol(std::string_view symbolName);
+  void defineSymbol(std::string_view symbolName);
 
-  void openNewSection(const std::string& sectionName);
+  void openNewSection(std::string_view sectionName);
 
-  void insertSymbol(const std::string& symbolName);
+  void insertSymbol(std::string_view symbolName);
   void insertLiteral(uint32_t value);
   void insertBSS(uint32_t numBytes);
 
@@ -44,15 +47,43 @@ public:
   void insertJumpInstructionLiteral(InstructionTypes instructionType, const Parameters&& parameters);
   void insertJumpInstructionSymbol(InstructionTypes instructionType, const Parameters&& parameters);
 
+  // operandi kao izrazi (sym + 8, end - start, (A - B) / 4). Cvorovi se prave pri parsiranju, a vrednost
+  // se racuna na kraju asembliranja: konstanta se upisuje, a simbol uvecan za konstantu dobija relokaciju
+  uint32_t makeLiteralExpression(uint32_t value);
+  uint32_t makeSymbolExpression(std::string_view symbolName);
+  uint32_t makeOperationExpression(ExpressionOperator op, uint32_t left, uint32_t right = 0);
+
+  void insertWordExpression(uint32_t expression);
+  void insertLoadInstructionExpression(MemoryInstructionType instructionType, uint32_t expression, uint8_t destReg);
+  void insertStoreInstructionExpression(MemoryInstructionType instructionType, uint8_t srcReg, uint32_t expression);
+  void insertJumpInstructionExpression(InstructionTypes instructionType, uint8_t regB, uint8_t regC, uint32_t expression);
+
   void endAssembly();
+  // popunjeno posle endAssembly. Koriscenja simbola pokazuju u arenu asemblera
+  AssemblerOutputData& getOutputData() { return outputData; }
+
+  // skener salje imena simbola iz bazena, vaze do kraja asembliranja i ne oslobadjaju se pojedinacno
+  const char* internName(std::string_view name);
+
+  void nextLine() { ++sourceFileLine; }
+  uint32_t getSourceFileLine() const { return sourceFileLine; }
 private:
-  uint32_t findSymbol(const std::string& symbolName) const;
+  uint32_t findSymbol(std::string_view symbolName) const;
+  uint32_t insertNewSymbol(std::string_view symbolName, uint32_t sectionNumber, int value,
+                           bool isGlobal, bool isExtern, bool isDefined, uint32_t size);
+  void addSymbolUsage(uint32_t symbolIndex, AssemblerInstruction instruction, uint32_t offset);
   uint32_t findPoolOffset(uint32_t symbolIndex) const;
+  uint32_t getSymbolPoolOffset(uint32_t symbolIndex);
+  uint32_t getExpressionPoolOffset(uint32_t expression);
+  void writeLoadFromPool(MemoryInstructionType instructionType, uint8_t destReg, uint32_t poolOffset);
+  void writeStoreFromPool(MemoryInstructionType instructionType, uint8_t srcReg, uint32_t poolOffset);
+  void writeJumpFromPool(InstructionTypes instructionType, uint8_t regB, uint8_t regC, uint32_t poolOffset);
   void closeCurrentSection();
 
   void validateSymbolTable();
   void patchFromLiteralPool();
   void backpatch();
+  void resolveExpressions();
   void createRelocationTables();
 
   std::vector<Symbol> symbolTable;
@@ -60,11 +91,19 @@ private:
   std::unordered_map<uint32_t, SectionMemory> sectionMemoryMap;
   std::unordered_map<uint32_t, std::vector<RelocationEntry>> sectionRelocationMap;
   std::unordered_map<uint32_t, std::vector<LiteralPoolPatch>> sectionPoolPatchesMap;
+  std::vector<ExpressionNode> expressions;
+  std::vector<ExpressionUsage> expressionUsages;
+
+  common::StringPool namePool;
+  std::unordered_map<std::string_view, uint32_t> symbolIndexMap; // kljucevi su iz namePool
+  common::ChunkedArena<SymbolUsageNode> usageArena;
 
   std::string outputFilePath;
+  AssemblerOutputData outputData;
   
   uint32_t currentSectionNumber = 0; // indeks trenutne sekcije u tabeli simbola. 0 - UND
   uint32_t locationCounter = 0; // trenutna velicina generisanog koda sekcije
+  uint32_t sourceFileLine = 1; // trenutna linija izvornog fajla, za poruke o greskama
 };
 
 } // namespace asm_core
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <assembler/assembly_cache.hpp>
+#include <linker/linker_structures.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace asm_core
+{
+
+struct AssemblerJob
+{
+  std::string inputFilePath;
+  std::string outputFilePath;
+};
+
+// komandna linija asemblera: [-threads=n] [-timing] [-cache=dir] [-cache-stats] -o izlaz1 ulaz1 [-o izlaz2 ulaz2 ...]
+struct AssemblerCommand
+{
+  std::vector<AssemblerJob> jobs;
+  uint32_t numThreads = 0;
+  bool timing = false;
+  std::string cacheDirectory; // prazno: bez kesa objektnih fajlova
+  bool printCacheStatistics = false;
+};
+
+// argumenti bez imena programa. Bez -cache= opcije kes je ASSEMBLER_CACHE_DIR, ako je postavljen.
+// Baca RuntimeError sa ispravnom sintaksom ako nema nijednog posla
+AssemblerCommand parseAssemblerCommand(const std::vector<std::string>& arguments);
+
+// -timing: leksicka analiza se meri zasebnim prolazom kroz skener, parsiranje je ostatak vremena parsera
+struct AssemblyTimes
+{
+  uint64_t sourceBytes = 0;
+  uint64_t readMicroseconds = 0;
+  uint64_t lexMicroseconds = 0;
+  uint64_t parseMicroseconds = 0; // parsiranje i generisanje koda, bez leksicke analize
+};
+
+// asemblira jedan fajl sa sopstvenim asemblerom, parserom i skenerom. Ulaz se cita jednim citanjem i
+// skenira direktno iz memorije. Sa kesom se pri pogotku samo kopira gotov objektni fajl. Baca izuzetak pri gresci
+void assembleFile(
+  const std::string& inputFilePath,
+  const std::string& outputFilePath,
+  AssemblyTimes* times = nullptr,
+  AssemblyCache* cache = nullptr);
+
+// asemblira fajl za linkovanje u istom procesu, bez citanja objektnog fajla.
+// Ako outputFilePath nije prazan, objektni fajl se i upisuje
+lnk_core::LinkerInputData assembleToLinkerInput(
+  const std::string& inputFilePath,
+  const std::string& outputFilePath = "",
+  AssemblyTimes* times = nullptr);
+
+// asemblira fajlove istovremeno na skupu niti (0: broj jezgara).
+// Vraca poruku o gresci za svaki posao, redom kao poslovi (prazna ako je fajl uspesno asembliran)
+std::vector<std::string> assembleFiles(
+  const std::vector<AssemblerJob>& jobs,
+  uint32_t numThreads = 0,
+  std::vector<AssemblyTimes>* times = nullptr,
+  AssemblyCache* cache = nullptr);
+
+void printAssemblyTimes(const std::string& inputFilePath, const AssemblyTimes& times, std::ostream& out = std::cout);
+
+} // namespace asm_core
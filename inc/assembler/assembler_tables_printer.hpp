@@ -13,6 +13,8 @@ class AssemblerTablesPrinter
 {
 public:
   static void printTables(const common::AssemblerOutputData& data, const std::string& filePath);
+  // tabele se upisuju pored objektnog fajla, sa ekstenzijom .objdump
+  static std::string getObjDumpPath(const std::string& filePath);
 private:
   static void printSymbolTable(const std::vector<common::Symbol>& symbolTable, std::ofstream& outFile);
   static void printRelocationTables(const common::AssemblerOutputData& data, std::ofstream& outFile);
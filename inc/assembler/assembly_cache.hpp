@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace asm_core
+{
+
+struct AssemblyCacheStatistics
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+/*
+Kes asembliranih objektnih fajlova na disku, adresiran sadrzajem. Kljuc je 128-bitni hes izvornog koda i
+identiteta asemblera (velicina i vreme izmene izvrsnog fajla), pa isti izvor na drugoj grani ili u drugom
+CI poslu daje gotov objektni fajl bez asembliranja. Unos su objektni fajl i tabele (.objdump):
+  <direktorijum>/<prva dva znaka kljuca>/<kljuc>.o
+  <direktorijum>/<prva dva znaka kljuca>/<kljuc>.objdump
+  <direktorijum>/stats                       ukupni pogoci i promasaji svih procesa
+Unosi se upisuju preko privremenog fajla i preimenovanja, pa vise procesa sme istovremeno da koristi kes.
+Greske kesa ne prekidaju asembliranje: nedostupan unos je promasaj, a neuspeo upis se preskace
+*/
+class AssemblyCache
+{
+public:
+  explicit AssemblyCache(const std::string& directory);
+
+  std::string getKey(std::string_view source) const;
+
+  // pri pogotku kopira objektni fajl i tabele na izlazne putanje
+  bool fetch(const std::string& key, const std::string& outputFilePath);
+  // cuva objektni fajl i tabele koje je asembler upravo upisao
+  void store(const std::string& key, const std::string& outputFilePath);
+
+  AssemblyCacheStatistics getStatistics() const { return {numHits, numMisses}; }
+  // dodaje statistiku od poslednjeg poziva ukupnoj statistici u direktorijumu kesa i vraca ukupnu
+  AssemblyCacheStatistics recordStatistics();
+  void printStatistics(const AssemblyCacheStatistics& totalStatistics, std::ostream& out) const;
+private:
+  std::string getEntryPath(const std::string& key, const char* extension) const;
+
+  std::string directory;
+  std::atomic<uint64_t> numHits{0};
+  std::atomic<uint64_t> numMisses{0};
+  AssemblyCacheStatistics recordedStatistics; // vec dodato u fajl statistike
+};
+
+} // namespace asm_core
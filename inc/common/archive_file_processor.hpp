@@ -0,0 +1,46 @@
+#pragma once
+
+#include <linker/linker_structures.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace common
+{
+
+struct ArchiveMember
+{
+  std::string name;
+  uint64_t offset; // u odnosu na pocetak dela sa podacima
+  uint64_t size;
+};
+
+// zaglavlje arhive: clanovi i indeks globalnih simbola, clanovi se citaju tek kada zatrebaju
+struct ArchiveIndex
+{
+  std::string filePath;
+  std::vector<ArchiveMember> members;
+  std::unordered_map<std::string, uint32_t> symbolIndex; // kljuc: ime simbola, vrednost: indeks clana
+  uint64_t dataOffset = 0; // pocetak podataka u fajlu
+};
+
+/*
+Staticka biblioteka objektnih fajlova:
+  !archive
+  Member:ime:offset:velicina
+  Symbol:ime:indeksClana
+  Data:
+  <objektni fajlovi jedan za drugim>
+*/
+class ArchiveFileProcessor
+{
+public:
+  static void writeToFile(const std::vector<std::string>& memberFilePaths, const std::string& archiveFilePath);
+  static bool isArchive(const std::string& filePath);
+  static ArchiveIndex readIndex(const std::string& archiveFilePath);
+  static lnk_core::LinkerInputData readMember(const ArchiveIndex& index, uint32_t memberIndex);
+};
+
+} // namespace common
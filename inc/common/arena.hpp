@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace common
+{
+
+// blokovi fiksnog kapaciteta: elementi se nikad ne premestaju, pokazivaci vaze dok arena postoji
+template<typename T, size_t CHUNK_SIZE = 1024>
+class ChunkedArena
+{
+public:
+  ChunkedArena() = default;
+  ChunkedArena(const ChunkedArena&) = delete;
+  ChunkedArena& operator=(const ChunkedArena&) = delete;
+
+  template<typename... Args>
+  T* create(Args&&... args)
+  {
+    if(chunks.empty() || chunks.back().size() == CHUNK_SIZE)
+    {
+      chunks.emplace_back();
+      chunks.back().reserve(CHUNK_SIZE); // blok se ne puni preko kapaciteta, pa se nikad ne realocira
+    }
+    return &chunks.back().emplace_back(std::forward<Args>(args)...);
+  }
+
+  size_t size() const { return chunks.empty() ? 0 : (chunks.size() - 1) * CHUNK_SIZE + chunks.back().size(); }
+private:
+  std::vector<std::vector<T>> chunks;
+};
+
+// jedinstvena kopija svakog stringa u blokovima memorije, zavrsena nulom. Pogledi vaze dok bazen postoji
+class StringPool
+{
+public:
+  StringPool() = default;
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  std::string_view intern(std::string_view text);
+  size_t size() const { return strings.size(); }
+private:
+  static constexpr size_t CHUNK_SIZE = 16 * 1024;
+
+  char* allocate(size_t size);
+
+  std::vector<std::unique_ptr<char[]>> chunks;
+  std::vector<std::unique_ptr<char[]>> largeStrings;
+  size_t chunkUsed = CHUNK_SIZE; // prvi intern otvara blok
+  std::unordered_set<std::string_view> strings;
+};
+
+} // namespace common
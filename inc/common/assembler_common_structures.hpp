@@ -111,7 +111,18 @@ enum StatusRegister
 {
   STATUS,
   HANDLER,
-  CAUSE
+  CAUSE,
+  // brojaci performansi (samo za citanje)
+  INSTRET, // broj izvrsenih instrukcija, nizih 32b
+  INSTRETH, // broj izvrsenih instrukcija, visih 32b
+  BRTAKEN, // broj skokova uslovnih grananja
+  BRNOTTAKEN, // broj uslovnih grananja bez skoka
+  MEMRD, // broj citanja podataka iz memorije
+  MEMWR, // broj upisa podataka u memoriju
+  INTCNT, // ukupan broj prihvacenih prekida
+  HOSTTIME, // vreme izvrsavanja na domacinu u mikrosekundama, nizih 32b
+  CYCLE, // procenjeni broj ciklusa iz modela ciklusa, nizih 32b
+  CYCLEH // procenjeni broj ciklusa iz modela ciklusa, visih 32b
 };
 
 struct AssemblerInstruction
@@ -160,6 +171,75 @@ struct SymbolUsage
     : instruction(instruction), sectionNumber(sectionNumber), offset(offset) {}
 };
 
+enum class ExpressionOperator
+{
+  LITERAL, SYMBOL, // listovi
+  ADD, SUB, MUL, DIV, NEG
+};
+
+// cvor izraza iz operanda (sym + 8, (A - B) / 4). Izrazi samo od literala se racunaju pri parsiranju,
+// ostali na kraju asembliranja, kada su poznate vrednosti svih simbola
+struct ExpressionNode
+{
+  ExpressionOperator op;
+  uint32_t value; // LITERAL: vrednost, SYMBOL: indeks u tabeli simbola
+  uint32_t left; // indeksi operanada u nizu cvorova asemblera
+  uint32_t right;
+};
+
+// mesto koje dobija vrednost izraza: rec u kodu (WORD) ili u bazenu literala (POOL)
+struct ExpressionUsage
+{
+  uint32_t expression;
+  OperationCodes oc;
+  uint32_t sectionNumber;
+  uint32_t offset; // WORD: offset u kodu sekcije, POOL: offset u bazenu sekcije
+  uint32_t sourceFileLine; // za greske pri racunanju izraza
+};
+
+// cvor koriscenja u areni asemblera (ChunkedArena), ne premesta se do kraja asembliranja
+struct SymbolUsageNode
+{
+  SymbolUsage usage;
+  SymbolUsageNode* next = nullptr;
+
+  SymbolUsageNode(AssemblerInstruction instruction, uint32_t sectionNumber, uint32_t offset)
+    : usage(instruction, sectionNumber, offset) {}
+};
+
+// ulancana lista koriscenja, redosledom dodavanja. Ne poseduje cvorove, kopija deli iste cvorove
+class SymbolUsageList
+{
+public:
+  class Iterator
+  {
+  public:
+    explicit Iterator(const SymbolUsageNode* node) : node(node) {}
+
+    const SymbolUsage& operator*() const { return node->usage; }
+    Iterator& operator++() { node = node->next; return *this; }
+    bool operator!=(const Iterator& other) const { return node != other.node; }
+  private:
+    const SymbolUsageNode* node;
+  };
+
+  void append(SymbolUsageNode* node)
+  {
+    (last == nullptr ? first : last->next) = node;
+    last = node;
+    ++count;
+  }
+  void clear() { first = last = nullptr; count = 0; }
+
+  Iterator begin() const { return Iterator(first); }
+  Iterator end() const { return Iterator(nullptr); }
+  uint32_t size() const { return count; }
+private:
+  SymbolUsageNode* first = nullptr;
+  SymbolUsageNode* last = nullptr;
+  uint32_t count = 0;
+};
+
 struct Symbol
 {
   std::string name; // ime simbola
@@ -169,7 +249,7 @@ struct Symbol
   bool isExtern; // SIMBOL: da li je simbol eksterni (uvozimo ga) SEKCIJA: UNUSED
   bool isDefined; // SIMBOL: da li je simbol definisan SEKCIJA: UNUSED
   uint32_t size; // SIMBOL: UNUSED, SEKCIJA: velicina
-  std::vector<SymbolUsage> symbolUsages; // sva koriscenja simbola u kodu
+  SymbolUsageList symbolUsages; // sva koriscenja simbola u kodu, cvorovi su u areni asemblera
 
   Symbol(const std::string& name, uint32_t sectionNumber, int value, bool isGlobal, 
                                       bool isExtern, bool isDefined, uint32_t size)
@@ -182,17 +262,25 @@ class SectionMemory
 public:
   using MemorySegment = std::vector<uint8_t>;
 
+  struct WordPatch
+  {
+    uint32_t address; // offset u kodu sekcije
+    uint32_t value; // vrednost koja se dodaje reci na adresi
+  };
+
   void writeInstruction(AssemblerInstruction instruction);
   void writeWord(uint32_t instruction);
   void writeBSS(uint32_t numBytes);
   void writeBytes(const MemorySegment& bytes);
   uint32_t writeLiteral(uint32_t literal);
 
+  // citanje i izmena reci u mestu (little-endian), bez alokacije
   uint32_t readCode(uint32_t address) const;
+  void writeCode(uint32_t address, uint32_t value);
+  void writeLiteralPool(uint32_t address, uint32_t value);
   void addToAddress(uint32_t address, uint32_t value);
-
-  void repairMemory(uint32_t start, MemorySegment repairBytes);
-  void repairLiteralPool(uint32_t start, MemorySegment repairBytes);
+  void addToAddresses(const WordPatch* begin, const WordPatch* end); // zakrpe sortirane po adresi
+  static void addToWords(uint8_t* buffer, uint32_t bufferSize, const WordPatch* begin, const WordPatch* end);
 
   uint32_t getSectionSize() const { return code.size() + literalPool.size(); }
   uint32_t getCodeSize() const { return code.size(); }
@@ -203,9 +291,10 @@ public:
   const MemorySegment& getCode() const { return code; }
   const MemorySegment& getLiteralPool() const { return literalPool; } 
 
-  static MemorySegment toMemorySegment(uint32_t value);
-  static MemorySegment toMemorySegment(AssemblerInstruction instruction);
+  static uint32_t toWord(AssemblerInstruction instruction);
 private:
+  static void checkWordAddress(uint32_t bufferSize, uint32_t address, const char* methodName);
+
   MemorySegment code;
   MemorySegment literalPool;
 };
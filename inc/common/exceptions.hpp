@@ -1,9 +1,9 @@
 #pragma once
 
-#include <assembler/assembler_common.hpp>
 #include <emulator/emulator_structures.hpp>
 
 #include <array>
+#include <cstdint>
 #include <exception>
 #include <string>
 
@@ -19,6 +19,8 @@ enum ErrorCode
   UNRECOGNIZED_INSTRUCTION,
   VALUE_OVERFLOW,
   BACKPATCHING_ERROR,
+  SYNTAX_ERROR,
+  EXPRESSION_ERROR,
   NUM_ERRORS
 };
 
@@ -30,26 +32,36 @@ const static std::array<std::string, ErrorCode::NUM_ERRORS> errorMessages =
   "Instrukcija koriscena van sekcije!",
   "Instrukcija nije prepoznata od strane asemblera!",
   "Velicina operanda je prevelika za instrukciju!",
-  "Greska u backpatchingu!"
+  "Greska u backpatchingu!",
+  "Sintaksna greska!",
+  "Greska u izrazu!"
 };
 
+// linija se prosledjuje iz asemblera koji je greska zatekla, vise fajlova se moze asemblirati istovremeno
 class AssemblerError : public std::exception 
 {
 public:
-  AssemblerError(ErrorCode errorCode) : errorCode(errorCode) {}
+  AssemblerError(ErrorCode errorCode, uint32_t sourceFileLine, const std::string& detail = "")
+    : errorCode(errorCode), sourceFileLine(sourceFileLine)
+  {
+    message = std::string("AsemblerError, Linija ") + std::to_string(sourceFileLine) + ": " + errorMessages[errorCode];
+    if(!detail.empty())
+    {
+      message += " " + detail;
+    }
+  }
 
   const char* what() const noexcept override
   {
-    static std::string message;
-    message = std::string("AsemblerError, Linija ") + 
-              std::to_string(AssemblerCommon::currentSourceFileLine) 
-              + ": " 
-              + errorMessages[errorCode];
-    
     return message.c_str();
   }
+
+  ErrorCode getErrorCode() const { return errorCode; }
+  uint32_t getSourceFileLine() const { return sourceFileLine; }
 private:
   ErrorCode errorCode;
+  uint32_t sourceFileLine;
+  std::string message;
 };
 
 class RuntimeError : public std::exception
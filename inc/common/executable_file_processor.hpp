@@ -11,10 +11,18 @@ namespace common
 
 using namespace lnk_core;
 
+// neprekidan deo memorije koji se upisuje u izvrsni fajl, pokazuje na izlaznu sliku linkera
+struct OutputSegment
+{
+  uint32_t startAddress;
+  const uint8_t* bytes;
+  uint32_t size;
+};
+
 class ExecutableFileProcessor
 {
 public:
-  static void writeToFile(const std::vector<GlobalSectionData> globalSectionData, const std::string& outputFilePath);
+  static void writeToFile(const std::vector<OutputSegment>& segments, const std::string& outputFilePath);
   static emulator_core::CodeSegments readFromFile(const std::string& inputFilePath);
 };
 
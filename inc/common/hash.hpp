@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace common
+{
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// FNV-1a, 64 bita. Nastavlja se prosledjivanjem prethodnog rezultata kao pocetne vrednosti
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for(size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+inline uint64_t fnv1a(const std::string& text, uint64_t hash = FNV_OFFSET_BASIS)
+{
+  // duzina se ukljucuje da se nizovi stringova ne bi poklapali pri drugacijoj podeli
+  uint64_t size = text.size();
+  hash = fnv1a(&size, sizeof(size), hash);
+  return fnv1a(text.data(), text.size(), hash);
+}
+
+inline uint64_t fnv1a(uint64_t value, uint64_t hash)
+{
+  return fnv1a(&value, sizeof(value), hash);
+}
+
+} // namespace common
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace common
+{
+
+// deo izlazne sekcije koji je doprineo jedan ulazni fajl
+struct LinkStateInputSection
+{
+  uint32_t sectionNumber; // broj sekcije u tabeli simbola ulaznog fajla
+  uint32_t globalSectionId; // indeks izlazne sekcije
+  uint32_t offset; // pocetak dela ulaznog fajla u izlaznoj sekciji
+};
+
+struct LinkStateInput
+{
+  std::string filePath;
+  uint64_t contentHash; // FNV-1a celog fajla
+  uint64_t layoutHash; // FNV-1a tabele simbola (i referenci relokacija za -gc-sections), 0 za arhive
+  std::vector<LinkStateInputSection> sections; // samo zadrzane sekcije
+};
+
+struct LinkStateSection
+{
+  std::string name;
+  uint32_t startAddress;
+  uint32_t size;
+  uint32_t imageOffset;
+};
+
+struct LinkStateSymbol
+{
+  std::string name;
+  uint32_t value;
+};
+
+// stanje linkovanja koje se cuva pored izlaznog fajla za inkrementalno linkovanje
+struct LinkState
+{
+  uint64_t optionsHash; // opcije i spisak ulaznih fajlova
+  std::vector<LinkStateSection> sections;
+  std::vector<LinkStateSymbol> symbols;
+  std::vector<LinkStateInput> inputs;
+  std::vector<uint8_t> image; // prepravljena izlazna slika
+};
+
+/*
+Tekstualno zaglavlje, pa izlazna slika bez konverzije:
+  !lnkstate
+  Options:hes
+  Section:ime:pocetak:velicina:offsetUSlici
+  Symbol:ime:vrednost
+  Input:hesSadrzaja:hesRasporeda:putanja
+  InputSection:brojSekcije:indeksIzlazneSekcije:offset
+  Image:velicina
+  <bajtovi>
+*/
+class LinkStateFileProcessor
+{
+public:
+  static void writeToFile(const LinkState& state, const std::string& filePath);
+  // vraca false ako fajl ne postoji ili nije ispravan, tada se radi potpuno linkovanje
+  static bool readFromFile(const std::string& filePath, LinkState& state);
+};
+
+} // namespace common
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace common
+{
+
+struct MapEntry
+{
+  std::string name;
+  uint32_t address;
+  uint32_t size; // SEKCIJA: velicina, SIMBOL: UNUSED
+};
+
+struct MapFileData
+{
+  std::vector<MapEntry> sections;
+  std::vector<MapEntry> symbols;
+};
+
+// mapa memorije koju pravi linker (-map opcija), emulator je koristi da adrese prevede u sekcije i simbole
+class MapFileProcessor
+{
+public:
+  static void writeToFile(const MapFileData& data, const std::string& filePath);
+  static MapFileData readFromFile(const std::string& filePath);
+};
+
+} // namespace common
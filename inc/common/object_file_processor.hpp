@@ -6,6 +6,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <sstream>
@@ -18,13 +19,10 @@ class ObjectFileProcessor
 public:
     static void writeToFile(const AssemblerOutputData& data, const std::string& filePath);
     static lnk_core::LinkerInputData readFromFile(const std::string& filePath);
-private:
-    // Pomoćne funkcije za parsiranje
-
-    static Symbol parseSymbol(const std::string& line);
-    static uint32_t parseSectionNumber(const std::string& line);
-    static RelocationEntry parseRelocationEntry(const std::string& line);
-    static std::vector<uint8_t> parseSectionData(const std::string& line);
+    // jedan prolaz nad tekstom objektnog fajla, bez kopiranja redova i polja
+    static lnk_core::LinkerInputData readFromBuffer(std::string_view text);
+    // isto sto daje upis pa citanje objektnog fajla, bez fajla i bez formatiranja
+    static lnk_core::LinkerInputData toLinkerInputData(AssemblerOutputData&& data);
 };
 
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace common
+{
+
+struct ProfileEntry
+{
+  std::string name; // ime sekcije
+  uint64_t count; // izvrsene instrukcije
+};
+
+// profil izvrsavanja koji pravi emulator (-profile opcija), linker ga koristi za raspored sekcija
+class ProfileFileProcessor
+{
+public:
+  static void writeToFile(const std::vector<ProfileEntry>& entries, const std::string& filePath);
+  static std::vector<ProfileEntry> readFromFile(const std::string& filePath);
+};
+
+} // namespace common
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+
+// fiksni skup niti za paralelne petlje, pozivajuca nit takodje izvrsava zadatke
+class ThreadPool
+{
+public:
+  explicit ThreadPool(uint32_t numThreads = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  uint32_t getNumThreads() const { return workers.size() + 1; }
+
+  // poziva task(i) za svako i iz [0, numTasks) i vraca se kada se svi zavrse.
+  // Prvi izuzetak iz zadatka se ponovo baca u pozivajucoj niti. Ugnjezdeni pozivi nisu podrzani.
+  void parallelFor(uint32_t numTasks, const std::function<void(uint32_t)>& task);
+private:
+  void workerLoop();
+  void runTasks();
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wakeCondition;
+  std::condition_variable doneCondition;
+
+  const std::function<void(uint32_t)>* currentTask = nullptr;
+  uint32_t numTasks = 0;
+  std::atomic<uint32_t> nextTask{0};
+  uint32_t numActiveWorkers = 0;
+  uint64_t generation = 0; // broj pokrenutih paralelnih petlji
+  bool isStopping = false;
+  std::exception_ptr firstException;
+};
+
+} // namespace common
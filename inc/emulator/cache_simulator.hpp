@@ -0,0 +1,108 @@
+#pragma once
+
+#include <emulator/memory_map.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace emulator_core
+{
+
+enum class ReplacementPolicy
+{
+  LRU, FIFO, RANDOM
+};
+
+struct CacheConfig
+{
+  std::string name;
+  uint32_t size; // u bajtovima
+  uint32_t associativity; // broj ulaza u skupu
+  uint32_t lineSize; // u bajtovima
+  ReplacementPolicy policy;
+
+  // format opisa: velicina:asocijativnost:velicinaLinije:politika (lru, fifo, random)
+  static CacheConfig parse(const std::string& name, const std::string& description);
+};
+
+struct CacheOptions
+{
+  std::vector<CacheConfig> instructionCaches; // nivoi samo za dohvatanje instrukcija
+  std::vector<CacheConfig> dataCaches; // nivoi samo za podatke
+  std::vector<CacheConfig> unifiedCaches; // zajednicki nivoi ispod instrukcijskih i kesova podataka
+  std::string mapFilePath; // mapa memorije linkera za statistiku po sekcijama i simbolima
+
+  bool isEnabled() const { return !instructionCaches.empty() || !dataCaches.empty() || !unifiedCaches.empty(); }
+};
+
+// jedan nivo skupno-asocijativnog kesa, write-allocate
+class CacheLevel
+{
+public:
+  CacheLevel(const CacheConfig& config);
+
+  bool access(uint32_t address); // true ako je pogodak
+
+  const CacheConfig& getConfig() const { return config; }
+  uint64_t getHits() const { return hits; }
+  uint64_t getMisses() const { return misses; }
+private:
+  struct Line
+  {
+    uint32_t tag = 0;
+    uint64_t stamp = 0; // LRU: poslednji pristup, FIFO: trenutak punjenja
+    bool isValid = false;
+  };
+
+  uint32_t chooseVictim(uint32_t firstWay);
+
+  CacheConfig config;
+  uint32_t numSets;
+  uint32_t lineShift;
+  std::vector<Line> lines; // numSets * associativity
+
+  uint64_t clock = 0;
+  uint32_t randomState = 0x2545F491;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+};
+
+// hijerarhija kesova koja se kaci na Memory (kompajlira se samo uz EMULATOR_CACHE_SIMULATION)
+class CacheSimulator
+{
+public:
+  CacheSimulator(const CacheOptions& options);
+
+  void fetch(uint32_t address) { access(instructionPath, address, true); }
+  void read(uint32_t address) { access(dataPath, address, false); }
+  void write(uint32_t address) { access(dataPath, address, false); }
+
+  void printReport() const;
+private:
+  struct RegionStatistics
+  {
+    uint64_t fetches = 0;
+    uint64_t fetchMisses = 0; // promasaji u prvom nivou
+    uint64_t dataAccesses = 0;
+    uint64_t dataMisses = 0; // promasaji u prvom nivou
+  };
+
+  void access(const std::vector<uint32_t>& path, uint32_t address, bool isFetch);
+  static void record(RegionStatistics& statistics, bool isFetch, bool isHit);
+  static void printRegions(
+    const std::vector<MemoryRegion>& regions,
+    const std::vector<RegionStatistics>& statistics,
+    const std::string& title);
+
+  std::vector<CacheLevel> levels;
+  std::vector<uint32_t> instructionPath; // indeksi u levels, od najblizeg procesoru
+  std::vector<uint32_t> dataPath;
+
+  MemoryMap memoryMap;
+  std::vector<RegionStatistics> sectionStatistics;
+  std::vector<RegionStatistics> symbolStatistics;
+  RegionStatistics unmappedStatistics;
+};
+
+} // namespace emulator_core
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <common/assembler_common_structures.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace emulator_core
+{
+
+// tabelarni model cene instrukcija u ciklusima, bez simulacije protocne obrade
+class CycleModel
+{
+public:
+  CycleModel();
+
+  // format fajla: po jedna linija "kljuc vrednost", kljuc je ime koda operacije
+  // (npr. DIV) ili memory, branch, interrupt, # pocinje komentar
+  void load(const std::string& filePath);
+
+  void retire(common::OperationCodes operationCode, bool isRedirected)
+  {
+    cycles += latencies[static_cast<uint8_t>(operationCode)];
+    cycles += isRedirected ? branchTakenPenalty : 0;
+  }
+  void memoryAccess() { cycles += memoryAccessPenalty; }
+  void interruptEntry() { cycles += interruptEntryCost; }
+
+  uint64_t getCycles() const { return cycles; }
+
+  void printReport(uint64_t instructionsRetired, uint64_t clockFrequency) const;
+private:
+  std::array<uint32_t, 256> latencies; // indeks: OperationCodes
+  uint32_t memoryAccessPenalty;
+  uint32_t branchTakenPenalty;
+  uint32_t interruptEntryCost;
+
+  uint64_t cycles = 0;
+};
+
+} // namespace emulator_core
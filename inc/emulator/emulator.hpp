@@ -1,8 +1,14 @@
 #pragma once
 
 #include <common/assembler_common_structures.hpp>
+#include <emulator/cycle_model.hpp>
 #include <emulator/memory.hpp>
+#include <emulator/performance_counters.hpp>
+#include <emulator/timer.hpp>
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -14,20 +20,49 @@ namespace emulator_core
 class Emulator
 {
 public:
-  Emulator(const std::string& inputFilePath);
+  Emulator(const std::string& inputFilePath, const EmulatorOptions& options = {});
+  // program je vec u memoriji (linker u istom procesu), izvrsni fajl se ne cita
+  Emulator(CodeSegments codeSegments, const EmulatorOptions& options = {});
   void emulate();
+  void raiseInterrupt(InterruptType interruptType); // bezbedno iz drugih niti
 private:
   static AssemblerInstruction toInstruction(uint32_t word);
   void executeInstruction(const AssemblerInstruction& instruction);
+  bool executeFused(const AssemblerInstruction& first, uint32_t pc);
+  static FusedPattern matchFused(const AssemblerInstruction& first, const AssemblerInstruction& second);
+  void retire(OperationCodes operationCode, bool isRedirected);
+  void handlePendingInterrupts();
   void executeInterrupt(InterruptType interruptType);
+  bool isInterruptEnabled(InterruptType interruptType) const;
   void push(uint32_t value);
   uint32_t pop();
 
+  uint32_t readMemory(uint32_t address);
+  void writeMemory(uint32_t address, uint32_t value);
+  void writeMemoryIndirect(uint32_t address, uint32_t value);
+
+  uint32_t readControl(uint8_t index) const;
+  void writeControl(uint8_t index, uint32_t value);
+  void printFusionReport() const;
+
   Memory memory;
   Context context;
+  PerformanceCounters counters;
+  CycleModel cycleModel;
+  Timer timer;
+  std::unique_ptr<InstructionPairProfile> pairProfile;
+  std::unique_ptr<SectionProfile> sectionProfile;
+  std::array<uint64_t, static_cast<uint8_t>(FusedPattern::NONE)> fusedCounts = {0};
+  EmulatorOptions options;
+#ifdef EMULATOR_CACHE_SIMULATION
+  std::unique_ptr<CacheSimulator> cacheSimulator;
+#endif
   std::string inputFilePath;
+  CodeSegments codeSegments;
 
   bool isRunning = true;
+  bool isBlockEnd = false; // PC je preusmeren ili je upisan status
+  std::atomic<uint32_t> pendingInterrupts{0}; // bit 1 << InterruptType za svaki prekid koji ceka
 };
 
 } // namespace emulator_core
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <emulator/cache_simulator.hpp>
+#include <emulator/timer.hpp>
+
 #include <array>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace emulator_core
@@ -25,6 +29,29 @@ enum class InterruptType : uint8_t
 
 using CodeSegments = std::vector<CodeSegment>;
 
+// parovi instrukcija koje asembler generise zajedno, izvrsavaju se kao jedna spojena instrukcija
+enum class FusedPattern : uint8_t
+{
+  IRET, // pop status; pop pc
+  LOAD_MEMORY, // ld simbol/literal, %r: r = mem[pc + d]; r = mem[r]
+  LOAD_PUSH, // ld $x, %r; push %r
+  PUSH_PAIR, // push; push
+  POP_PAIR, // pop; pop (i pop; ret)
+  NONE
+};
+
+struct EmulatorOptions
+{
+  bool printStatistics = false; // ispis brojaca performansi na kraju izvrsavanja
+  CacheOptions cacheOptions; // simulacija kesa, zahteva prevodjenje sa CACHE_SIM=1
+  std::string cycleModelFilePath; // ako nije prazno, latencije modela ciklusa se citaju iz fajla
+  TimerClock timerClock = TimerClock::HOST;
+  uint64_t clockFrequency = 50000000; // Hz, za preracunavanje ciklusa u vreme
+  bool fuseInstructions = true; // izvrsavanje parova instrukcija kao spojenih instrukcija
+  bool profilePairs = false; // ispis najcescih dinamickih parova instrukcija
+  std::string profileFilePath; // ako nije prazno, upisuje se broj izvrsenih instrukcija po sekciji (zahteva -map)
+};
+
 } // namespace emulator_core
 
 
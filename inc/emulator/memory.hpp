@@ -10,6 +10,8 @@ namespace emulator_core
 {
 constexpr uint8_t WORD_SIZE = 4;
 
+class CacheSimulator;
+
 class Memory
 {
 public:
@@ -19,13 +21,25 @@ public:
   void init(const CodeSegments& codeSegments);
   void reset();
 
+  uint32_t fetchWord(uint64_t address); // dohvatanje instrukcije
+  uint32_t peekWord(uint64_t address) { return loadWord(address, "Memory::peekWord"); } // bez kukica simulacije
   uint32_t readWord(uint64_t address);
   void writeWord(uint64_t address, uint32_t word);
   void writeWordIndirect(uint64_t address, uint32_t word);
 
+#ifdef EMULATOR_CACHE_SIMULATION
+  void attachCacheSimulator(CacheSimulator* simulator) { cacheSimulator = simulator; }
+#endif
+
 private:
+  uint32_t loadWord(uint64_t address, const char* methodName);
+
   std::unordered_map<uint64_t, uint32_t> memory;
   uint64_t size;
+
+#ifdef EMULATOR_CACHE_SIMULATION
+  CacheSimulator* cacheSimulator = nullptr;
+#endif
 };
 
 class Context
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace emulator_core
+{
+
+struct MemoryRegion
+{
+  std::string name;
+  uint32_t startAddress;
+  uint32_t size;
+};
+
+// prevodi adrese u sekcije i globalne simbole na osnovu mape memorije linkera
+class MemoryMap
+{
+public:
+  static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+
+  void load(const std::string& mapFilePath);
+
+  uint32_t findSection(uint32_t address) const { return find(sections, address); }
+  uint32_t findSymbol(uint32_t address) const { return find(symbols, address); }
+
+  const std::vector<MemoryRegion>& getSections() const { return sections; }
+  const std::vector<MemoryRegion>& getSymbols() const { return symbols; }
+private:
+  static uint32_t find(const std::vector<MemoryRegion>& regions, uint32_t address);
+
+  std::vector<MemoryRegion> sections; // sortirano po pocetnoj adresi
+  std::vector<MemoryRegion> symbols; // sortirano po adresi, velicina je do sledeceg simbola ili kraja sekcije
+};
+
+} // namespace emulator_core
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <common/assembler_common_structures.hpp>
+#include <emulator/emulator_structures.hpp>
+#include <emulator/memory_map.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace emulator_core
+{
+
+const char* toString(common::OperationCodes operationCode);
+const char* toString(InterruptType interruptType);
+
+// brojaci performansi, gost ih moze citati preko csrrd (registri od INSTRET pa nadalje)
+class PerformanceCounters
+{
+public:
+  void start();
+  void stop();
+
+  void retire(common::OperationCodes operationCode)
+  {
+    ++instructionsRetired;
+    ++opcodeCounts[static_cast<uint8_t>(operationCode)];
+  }
+  void branch(bool isTaken) { isTaken ? ++branchesTaken : ++branchesNotTaken; }
+  void memoryRead() { ++memoryReads; }
+  void memoryWrite() { ++memoryWrites; }
+  void interrupt(InterruptType interruptType) { ++interrupts[static_cast<uint8_t>(interruptType)]; }
+
+  uint64_t getInstructionsRetired() const { return instructionsRetired; }
+  uint64_t getHostTimeMicroseconds() const;
+
+  uint32_t readRegister(uint8_t index) const;
+  void printReport() const;
+private:
+  static constexpr uint8_t NUM_INTERRUPT_TYPES = static_cast<uint8_t>(InterruptType::SOFTWARE) + 1;
+
+  uint64_t instructionsRetired = 0;
+  std::array<uint64_t, 256> opcodeCounts = {0}; // indeks: OperationCodes
+  uint64_t branchesTaken = 0;
+  uint64_t branchesNotTaken = 0;
+  uint64_t memoryReads = 0;
+  uint64_t memoryWrites = 0;
+  std::array<uint64_t, NUM_INTERRUPT_TYPES> interrupts = {0}; // indeks: InterruptType
+
+  std::chrono::steady_clock::time_point startTime;
+  std::chrono::steady_clock::time_point stopTime;
+  bool isStopped = false;
+};
+
+// brojanje dinamickih parova uzastopnih instrukcija, osnova za dodavanje novih spojenih instrukcija
+class InstructionPairProfile
+{
+public:
+  InstructionPairProfile() : pairCounts(256 * 256, 0) {}
+
+  void record(common::OperationCodes operationCode)
+  {
+    uint8_t current = static_cast<uint8_t>(operationCode);
+    if(hasPrevious)
+    {
+      ++pairCounts[previous * 256 + current];
+    }
+    previous = current;
+    hasPrevious = true;
+  }
+
+  void printReport(uint32_t numPairs) const;
+private:
+  std::vector<uint64_t> pairCounts; // indeks: prva * 256 + druga
+  uint8_t previous = 0;
+  bool hasPrevious = false;
+};
+
+// broj izvrsenih instrukcija po sekciji (spojeni par se broji jednom), ulaz za -profile opciju linkera
+class SectionProfile
+{
+public:
+  explicit SectionProfile(const std::string& mapFilePath);
+
+  // uzastopne instrukcije su uglavnom u istoj sekciji, pa se sekcija trazi samo pri izlasku iz trenutne
+  void record(uint32_t pc)
+  {
+    if(pc - currentStart >= currentSize)
+    {
+      findSection(pc);
+    }
+    ++*currentCount;
+  }
+
+  void writeToFile(const std::string& filePath) const;
+private:
+  void findSection(uint32_t pc);
+
+  MemoryMap memoryMap;
+  std::vector<uint64_t> sectionCounts; // indeks: sekcija u mapi memorije
+  uint64_t unmappedCount = 0;
+  uint32_t currentStart = 0;
+  uint32_t currentSize = 0;
+  uint64_t* currentCount = &unmappedCount;
+};
+
+} // namespace emulator_core
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace emulator_core
+{
+
+enum class TimerClock
+{
+  HOST, // vreme domacina
+  CYCLES // procenjeni ciklusi iz modela ciklusa
+};
+
+// tajmer sa registrom tim_cfg, period se bira vrednoscu 0x0 - 0x7
+class Timer
+{
+public:
+  static constexpr uint32_t CONFIG_ADDRESS = 0xFFFFFF10; // tim_cfg
+
+  Timer(TimerClock clock, uint64_t clockFrequency);
+
+  void start(uint64_t cycles);
+  void configure(uint32_t config, uint64_t cycles);
+  bool update(uint64_t cycles); // true kada istekne period tajmera
+private:
+  uint64_t now(uint64_t cycles) const; // HOST: mikrosekunde, CYCLES: ciklusi
+  uint64_t toTicks(uint32_t milliseconds) const;
+
+  TimerClock clock;
+  uint64_t clockFrequency; // Hz, za CYCLES
+  uint64_t period = 0;
+  uint64_t nextDeadline = 0;
+  uint32_t pollCountdown = 1; // vreme domacina se ne cita posle svake instrukcije
+  std::chrono::steady_clock::time_point startTime;
+};
+
+} // namespace emulator_core
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <common/archive_file_processor.hpp>
 #include <common/assembler_common_structures.hpp>
+#include <common/executable_file_processor.hpp>
+#include <common/link_state_file_processor.hpp>
 #include <linker/linker_structures.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <vector>
 #include <string>
@@ -20,32 +24,87 @@ public:
   Linker(
         const std::vector<SectionPlacement>& sectionPlacements,
         const std::vector<std::string>& inputFilePaths,
-        const std::string& outputFilePath);
+        const std::string& outputFilePath,
+        const LinkerOptions& options = {});
+  // ulazi su vec u memoriji (asembler u istom procesu), inputNames sluze samo za poruke.
+  // Bez izlaznog fajla (prazan outputFilePath) rezultat je samo u getOutputSegments
+  Linker(
+        const std::vector<SectionPlacement>& sectionPlacements,
+        std::vector<LinkerInputData> inputData,
+        const std::vector<std::string>& inputNames,
+        const std::string& outputFilePath,
+        const LinkerOptions& options = {});
 
   void performLinking();
 
+  // segmenti izlazne slike poredjani po adresi, vaze dok linker postoji
+  std::vector<OutputSegment> getOutputSegments() const;
+
+  const std::vector<PhaseTime>& getPhaseTimes() const { return phaseTimes; }
+
 private:
+  bool performIncrementalLinking();
+  void performRelocatableLinking();
+  void endPhase(const char* name);
+
   void readInputFiles();
+  void loadArchiveMembers(const std::vector<common::ArchiveIndex>& archives);
+  void removeUnreachableSections();
   void processProgramSections();
+  void recordInputSections();
 
-  bool isPlacingSectionsPossible();
+  void checkFixedPlacements();
   void findSectionsStartAddress();
+  void placeSections(
+    const std::vector<uint32_t>& placementOrder,
+    const std::vector<uint32_t>& sectionRegions,
+    uint64_t firstFreeAddress);
+  void orderByProfile(std::vector<uint32_t>& placementOrder, const std::vector<uint32_t>& sectionRegions,
+                      uint64_t firstFreeAddress);
+  uint64_t countTouchedPages(const std::vector<uint64_t>& sectionCounts) const;
+  std::vector<AddressInterval> getFixedIntervals();
+  std::vector<std::vector<AddressInterval>> findFreeGaps();
+  uint32_t findRegion(const std::string& regionName) const;
+  void buildOutputImage();
 
   void initGlobalSymbolTable();
+  void resolveSymbols();
   void patchRelocationEntries();
+  void patchRelocationSlice(
+    const LinkerInputData& data,
+    uint32_t sectionUsageNumber,
+    const std::vector<RelocationEntry>& relocationEntries);
+
+  void writeOutputFiles();
+  void writeRelocatableObject();
+  void writeMapFile();
+  void writeLinkState();
+  std::string getLinkStatePath() const { return outputFilePath + ".lnkstate"; }
+  uint64_t getOptionsHash() const;
+  uint64_t getLayoutHash(const LinkerInputData& data) const;
 
   void printLinkingInfo();
   void printGlobalSectionData();
   void printGlobalSymbolTable();
+  void printPhaseTimes();
+
+  GlobalSectionData& getGlobalSection(const std::string& sectionName);
 
-  std::unordered_map<std::string, GlobalSectionData> globalSectionDataMap;
-  std::unordered_map<std::string, uint32_t> globalSymbolTable; // kljuc: ime simbola, vrednost: vrednost simbola
+  std::vector<GlobalSectionData> globalSections; // redosled prvog pojavljivanja sekcije
+  std::unordered_map<std::string, uint32_t> globalSectionIds; // kljuc: ime sekcije, vrednost: indeks u globalSections
+  std::vector<GlobalSymbol> globalSymbols;
+  std::unordered_map<std::string, uint32_t> globalSymbolIds; // kljuc: ime simbola, vrednost: indeks u globalSymbols
+  std::vector<uint8_t> outputImage; // sve izlazne sekcije poredjane po adresi, jedna alokacija
 
-  std::vector<std::string> sectionOrder;
   std::vector<LinkerInputData> objectFilesData;
   std::vector<SectionPlacement> sectionPlacements;
   std::vector<std::string> inputFilePaths;
   std::string outputFilePath;
+  LinkerOptions options;
+  std::vector<PhaseTime> phaseTimes;
+  std::chrono::steady_clock::time_point phaseStart;
+  std::vector<LinkStateInput> inputStates; // -incremental: hesevi ulaznih fajlova, redom kao inputFilePaths
+  bool hasInputData = false; // ulazi su prosledjeni konstruktoru, ne citaju se fajlovi
 };
 
 } // namespace lnk_core
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <linker/linker_structures.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lnk_core
+{
+
+// komandna linija linkera, zajednicka za ./linker i server toolchaind
+struct LinkerCommand
+{
+  std::vector<SectionPlacement> placements;
+  std::vector<std::string> inputFilePaths;
+  std::string outputFilePath;
+  LinkerOptions options;
+};
+
+// argumenti bez imena programa. Baca RuntimeError za neispravnu ili nepotpunu komandnu liniju
+LinkerCommand parseLinkerCommand(const std::vector<std::string>& arguments);
+
+} // namespace lnk_core
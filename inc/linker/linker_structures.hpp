@@ -2,6 +2,8 @@
 
 #include <common/assembler_common_structures.hpp>
 
+#include <iostream>
+#include <string>
 #include <vector>
 #include <limits>
 #include <unordered_map>
@@ -11,24 +13,92 @@ namespace lnk_core
 
 constexpr uint32_t INVALID_NUMBER = UINT32_MAX;
 
+// deo izlazne sekcije iz jednog ulaznog fajla, pokazuje na ucitane bajtove tog fajla
+struct InputSectionView
+{
+  const uint8_t* bytes;
+  uint32_t size;
+};
+
 struct GlobalSectionData
 {
-  common::SectionMemory generatedCode;
+  std::string name;
+  std::vector<InputSectionView> inputSections; // po redosledu spajanja, vazi dok se ne napravi izlazna slika
+  uint32_t imageOffset = INVALID_NUMBER; // pocetak sekcije u izlaznoj slici
   uint32_t startAddress = INVALID_NUMBER;
   uint32_t size = INVALID_NUMBER;
 };
 
+struct GlobalSymbol
+{
+  std::string name;
+  uint32_t value;
+};
+
 struct LinkerInputData
 {
   std::vector<common::Symbol> symbolTable;
   std::unordered_map<uint32_t, std::vector<uint8_t>> sectionMemoryMap;
   std::unordered_map<uint32_t, std::vector<common::RelocationEntry>> sectionRelocationMap;
+
+  // popunjava linker, indeks je indeks u lokalnoj tabeli simbola
+  std::vector<uint32_t> globalSectionIds; // indeks u Linker::globalSections, INVALID_NUMBER ako nije sekcija
+  std::vector<uint32_t> globalSymbolIds; // indeks u Linker::globalSymbols, INVALID_NUMBER ako nije razresen
+  std::vector<bool> isLiveSection; // -gc-sections: dostupne sekcije, prazno ako se sekcije ne uklanjaju
+
+  bool isLive(uint32_t sectionNumber) const { return isLiveSection.empty() || isLiveSection[sectionNumber]; }
 };
 
 struct SectionPlacement
 {
   std::string sectionName;
   uint32_t startAddress;
+  std::string regionName; // ako nije prazno, sekcija se smesta bilo gde u imenovanu oblast (startAddress se ne koristi)
+};
+
+// imenovana oblast memorije u koju linker sam smesta sekcije
+struct PlacementRegion
+{
+  std::string name;
+  uint32_t startAddress;
+  uint64_t size;
+};
+
+// poluotvoren interval adresa [start, end)
+struct AddressInterval
+{
+  uint64_t start;
+  uint64_t end;
+  const std::string* sectionName; // nullptr za slobodne rupe i rezervisane opsege
+};
+
+enum class PlacementFit
+{
+  APPEND, // iza najvise fiksne sekcije, redom
+  FIRST_FIT, // prva slobodna rupa u koju sekcija staje
+  BEST_FIT // rupa u kojoj ostaje najmanje slobodnog prostora
+};
+
+struct LinkerOptions
+{
+  std::string mapFilePath; // ako nije prazno, upisuje se mapa memorije (sekcije i globalni simboli)
+  std::vector<PlacementRegion> regions; // bez oblasti, sekcije se smestaju u ceo adresni prostor bez MMIO
+  uint32_t alignment = 4; // poravnanje sekcija koje smesta linker, stepen dvojke
+  PlacementFit fit = PlacementFit::FIRST_FIT;
+  std::string profileFilePath; // profil emulatora, vruce sekcije bez fiksne adrese se smestaju prve i zajedno
+  bool gcSections = false; // uklanjanje sekcija nedostupnih iz korenih sekcija
+  std::vector<std::string> gcRoots; // korene sekcije pored sekcije smestene na adresu pokretanja
+  uint32_t numThreads = 0; // niti za prepravljanje relokacija, 0: broj jezgara
+  bool printTimings = false; // ispis trajanja faza linkovanja
+  bool relocatable = false; // spajanje ulaza u jedan relokatibilni objektni fajl umesto izvrsnog
+  bool incremental = false; // stanje se cuva u <izlaz>.lnkstate, ponovo se prepravljaju samo izmenjeni fajlovi
+  std::ostream* log = &std::cout; // informacije, tabele i vremena faza; server usmerava ispis u odgovor posla
+};
+
+struct PhaseTime
+{
+  std::string name;
+  uint64_t microseconds;
 };
 
 } // namespace lnk_core
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <linker/linker_structures.hpp>
+#include <toolchaind/toolchaind_protocol.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace toolchaind_core
+{
+
+// velicina i vreme izmene fajla, unos kesa vazi dok se ne promene
+struct FileStamp
+{
+  std::uintmax_t size = 0;
+  std::filesystem::file_time_type writeTime;
+
+  bool operator==(const FileStamp& other) const { return size == other.size && writeTime == other.writeTime; }
+};
+
+// parsirani objektni fajlovi koje su upisali ili procitali raniji poslovi, po apsolutnoj putanji
+class ObjectCache
+{
+public:
+  // nullptr ako fajla nema u kesu ili je izmenjen posle upisa u kes
+  std::shared_ptr<const lnk_core::LinkerInputData> find(const std::string& filePath);
+  void store(const std::string& filePath, const FileStamp& stamp, std::shared_ptr<const lnk_core::LinkerInputData> data);
+
+  // false ako fajl ne postoji
+  static bool getFileStamp(const std::string& filePath, FileStamp& stamp);
+
+  uint64_t getNumHits() const { return numHits; }
+private:
+  struct Entry
+  {
+    FileStamp stamp;
+    std::shared_ptr<const lnk_core::LinkerInputData> data;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<std::string, Entry> entries;
+  std::atomic<uint64_t> numHits{0};
+};
+
+// Dugovecni proces koji izvrsava poslove asemblera i linkera primljene preko Unix domain socket-a.
+// Svaka veza je jedan posao; poslovi se izvrsavaju istovremeno na radnim nitima, a objektni fajlovi
+// ostaju parsirani izmedju poslova, pa linkovanje posle asembliranja ne cita ponovo ono sto je server upisao
+class ToolchainServer
+{
+public:
+  ToolchainServer(const std::string& socketPath, uint32_t numWorkers = std::thread::hardware_concurrency());
+  ~ToolchainServer();
+
+  ToolchainServer(const ToolchainServer&) = delete;
+  ToolchainServer& operator=(const ToolchainServer&) = delete;
+
+  // prihvata veze dok ne stigne zahtev za gasenje, zatim zavrsava vec primljene poslove
+  void serve();
+
+  uint64_t getNumJobs() const { return numJobs; }
+  uint64_t getNumCacheHits() const { return objectCache.getNumHits(); }
+private:
+  void workerLoop();
+  void handleConnection(int connectionFd);
+  JobResult runJob(const std::vector<std::string>& request);
+  int32_t runAssembler(const std::vector<std::string>& arguments, std::ostream& out, std::ostream& err);
+  int32_t runLinker(const std::vector<std::string>& arguments, std::ostream& out);
+  std::shared_ptr<const lnk_core::LinkerInputData> loadObject(const std::string& filePath);
+  void stop();
+
+  std::string socketPath;
+  uint32_t numWorkers;
+  int listenFd = -1;
+  std::vector<std::thread> workers;
+  std::queue<int> pendingConnections;
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::atomic<bool> isStopping{false};
+  std::atomic<uint64_t> numJobs{0};
+
+  ObjectCache objectCache;
+};
+
+} // namespace toolchaind_core
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace toolchaind_core
+{
+
+// prvi string zahteva, ostali su argumenti komandne linije alata
+const std::string ASSEMBLER_REQUEST = "assembler";
+const std::string LINKER_REQUEST = "linker";
+const std::string STOP_REQUEST = "stop"; // server zavrsava primljene poslove i gasi se
+
+struct JobResult
+{
+  int32_t exitCode = 0;
+  std::string output; // standardni izlaz alata
+  std::string errors; // standardni izlaz za greske
+};
+
+// TOOLCHAIND_SOCKET ako je postavljen, inace /tmp/toolchaind-<uid>.sock
+std::string getDefaultSocketPath();
+
+// zauzima putanju socket-a (fajl koji je ostao od ugasenog servera se brise), pristup ima samo vlasnik
+int listenOnSocket(const std::string& socketPath);
+int connectToSocket(const std::string& socketPath);
+
+/*
+Poruke preko Unix domain socket-a, brojevi su uint32_t/int32_t u redosledu bajtova masine:
+  zahtev:  brojStringova, pa za svaki string duzina i bajtovi (vrsta zahteva, argumenti...)
+  odgovor: izlazniKod, duzina i bajtovi izlaza, duzina i bajtovi gresaka
+Za svaku vezu jedan zahtev i jedan odgovor. Greske u prenosu bacaju RuntimeError
+*/
+void writeRequest(int socketFd, const std::vector<std::string>& request);
+// false ako je druga strana zatvorila vezu pre zahteva
+bool readRequest(int socketFd, std::vector<std::string>& request);
+void writeResult(int socketFd, const JobResult& result);
+JobResult readResult(int socketFd);
+
+} // namespace toolchaind_core
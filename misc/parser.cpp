@@ -0,0 +1,1799 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "misc/parser.y"
+
+  #include <assembler/assembler.hpp>
+  #include <common/assembler_common_structures.hpp>
+  #include <common/exceptions.hpp>
+
+  #include <iostream>
+
+  using namespace common;
+
+#line 81 "misc/parser.cpp"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_LITERAL = 3,                    /* LITERAL  */
+  YYSYMBOL_SYMBOL = 4,                     /* SYMBOL  */
+  YYSYMBOL_GPRX = 5,                       /* GPRX  */
+  YYSYMBOL_CSRX = 6,                       /* CSRX  */
+  YYSYMBOL_GLOBAL = 7,                     /* GLOBAL  */
+  YYSYMBOL_EXTERN = 8,                     /* EXTERN  */
+  YYSYMBOL_SECTION = 9,                    /* SECTION  */
+  YYSYMBOL_WORD = 10,                      /* WORD  */
+  YYSYMBOL_SKIP = 11,                      /* SKIP  */
+  YYSYMBOL_END = 12,                       /* END  */
+  YYSYMBOL_HALT = 13,                      /* HALT  */
+  YYSYMBOL_INT = 14,                       /* INT  */
+  YYSYMBOL_IRET = 15,                      /* IRET  */
+  YYSYMBOL_CALL = 16,                      /* CALL  */
+  YYSYMBOL_RET = 17,                       /* RET  */
+  YYSYMBOL_JMP = 18,                       /* JMP  */
+  YYSYMBOL_BEQ = 19,                       /* BEQ  */
+  YYSYMBOL_BNE = 20,                       /* BNE  */
+  YYSYMBOL_BGT = 21,                       /* BGT  */
+  YYSYMBOL_PUSH = 22,                      /* PUSH  */
+  YYSYMBOL_POP = 23,                       /* POP  */
+  YYSYMBOL_XCHG = 24,                      /* XCHG  */
+  YYSYMBOL_ADD = 25,                       /* ADD  */
+  YYSYMBOL_SUB = 26,                       /* SUB  */
+  YYSYMBOL_MUL = 27,                       /* MUL  */
+  YYSYMBOL_DIV = 28,                       /* DIV  */
+  YYSYMBOL_NOT = 29,                       /* NOT  */
+  YYSYMBOL_AND = 30,                       /* AND  */
+  YYSYMBOL_OR = 31,                        /* OR  */
+  YYSYMBOL_XOR = 32,                       /* XOR  */
+  YYSYMBOL_SHL = 33,                       /* SHL  */
+  YYSYMBOL_SHR = 34,                       /* SHR  */
+  YYSYMBOL_LD = 35,                        /* LD  */
+  YYSYMBOL_ST = 36,                        /* ST  */
+  YYSYMBOL_CSRRD = 37,                     /* CSRRD  */
+  YYSYMBOL_CSRWR = 38,                     /* CSRWR  */
+  YYSYMBOL_ENDL = 39,                      /* ENDL  */
+  YYSYMBOL_LBRACK = 40,                    /* LBRACK  */
+  YYSYMBOL_RBRACK = 41,                    /* RBRACK  */
+  YYSYMBOL_COLON = 42,                     /* COLON  */
+  YYSYMBOL_COMMA = 43,                     /* COMMA  */
+  YYSYMBOL_DOLLAR = 44,                    /* DOLLAR  */
+  YYSYMBOL_PLUS = 45,                      /* PLUS  */
+  YYSYMBOL_MINUS = 46,                     /* MINUS  */
+  YYSYMBOL_STAR = 47,                      /* STAR  */
+  YYSYMBOL_SLASH = 48,                     /* SLASH  */
+  YYSYMBOL_LPAREN = 49,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 50,                    /* RPAREN  */
+  YYSYMBOL_NEGATION = 51,                  /* NEGATION  */
+  YYSYMBOL_YYACCEPT = 52,                  /* $accept  */
+  YYSYMBOL_program = 53,                   /* program  */
+  YYSYMBOL_lines = 54,                     /* lines  */
+  YYSYMBOL_line = 55,                      /* line  */
+  YYSYMBOL_label = 56,                     /* label  */
+  YYSYMBOL_statement = 57,                 /* statement  */
+  YYSYMBOL_instruction = 58,               /* instruction  */
+  YYSYMBOL_jumps = 59,                     /* jumps  */
+  YYSYMBOL_load = 60,                      /* load  */
+  YYSYMBOL_store = 61,                     /* store  */
+  YYSYMBOL_directive = 62,                 /* directive  */
+  YYSYMBOL_global_symbol_list = 63,        /* global_symbol_list  */
+  YYSYMBOL_extern_symbol_list = 64,        /* extern_symbol_list  */
+  YYSYMBOL_initializator_list = 65,        /* initializator_list  */
+  YYSYMBOL_initializator = 66,             /* initializator  */
+  YYSYMBOL_expression = 67                 /* expression  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 64 "misc/parser.y"
+
+  int yylex(YYSTYPE* yylval, yyscan_t scanner);
+  void yyerror(asm_core::Assembler& assembler, yyscan_t scanner, const char* message);
+  char* yyget_text(yyscan_t scanner);
+
+#line 189 "misc/parser.cpp"
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* !defined yyoverflow */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  83
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   245
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  52
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  16
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  69
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  172
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   306
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
+{
+       0,    74,    74,    77,    79,    82,    84,    87,    90,    92,
+      93,    97,    99,   101,   103,   105,   107,   109,   111,   113,
+     115,   117,   119,   121,   123,   125,   127,   129,   131,   133,
+     135,   137,   139,   142,   144,   146,   148,   150,   153,   155,
+     157,   159,   161,   163,   166,   168,   170,   172,   174,   177,
+     179,   181,   183,   185,   187,   192,   194,   197,   199,   202,
+     204,   208,   212,   214,   216,   218,   220,   222,   224,   226
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "LITERAL", "SYMBOL",
+  "GPRX", "CSRX", "GLOBAL", "EXTERN", "SECTION", "WORD", "SKIP", "END",
+  "HALT", "INT", "IRET", "CALL", "RET", "JMP", "BEQ", "BNE", "BGT", "PUSH",
+  "POP", "XCHG", "ADD", "SUB", "MUL", "DIV", "NOT", "AND", "OR", "XOR",
+  "SHL", "SHR", "LD", "ST", "CSRRD", "CSRWR", "ENDL", "LBRACK", "RBRACK",
+  "COLON", "COMMA", "DOLLAR", "PLUS", "MINUS", "STAR", "SLASH", "LPAREN",
+  "RPAREN", "NEGATION", "$accept", "program", "lines", "line", "label",
+  "statement", "instruction", "jumps", "load", "store", "directive",
+  "global_symbol_list", "extern_symbol_list", "initializator_list",
+  "initializator", "expression", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-42)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-11)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+     136,   -41,     2,    33,    35,     9,    40,   -42,   -42,   -42,
+     -42,     9,   -42,     9,    45,    51,    52,    54,    55,    56,
+      57,    58,    59,    60,    61,    63,    64,    65,    66,    67,
+       0,    68,    69,    71,    74,    96,   -42,   168,    38,   -42,
+     -42,   -42,   -42,   -42,   -42,   -42,    36,   -42,    37,   -42,
+     -42,   -42,     9,     9,    42,   -42,   -31,   -42,   -31,   -31,
+      43,    46,    47,   -42,   -42,    48,    50,    53,    93,    98,
+     -42,    99,   164,   165,   166,   167,   169,    73,     9,   -25,
+     170,   171,   172,   -42,   -42,    62,   -42,    83,    84,   -42,
+     -21,     9,     9,     9,     9,     9,    87,    89,    90,    92,
+      94,   206,   211,   212,   213,   214,   215,   216,   217,   218,
+     -34,   -15,   219,     5,   220,   221,   -42,   -42,   -42,   -42,
+     -42,   -12,   -12,   -42,   -42,   183,   185,   186,   -42,   -42,
+     -42,   -42,   -42,   -42,   -42,   -42,   -42,   -42,   -42,   187,
+      44,   226,   -42,   -42,   227,   -31,   -42,   -42,     9,     9,
+       9,   228,   193,   194,   -42,    -7,   -31,   -31,   -31,   -42,
+     195,   196,   -42,    49,   231,   232,   199,   200,   -42,   -42,
+     -42,   -42
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+      10,     0,     0,     0,     0,     0,     0,    54,    11,    12,
+      13,     0,    15,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     2,     3,    10,     0,     8,
+      14,    29,    30,     9,     7,    55,    49,    57,    50,    51,
+      62,    63,     0,     0,    52,    59,    61,    53,    33,    34,
+       0,     0,     0,    16,    17,     0,     0,     0,     0,     0,
+      23,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     1,     4,     0,     6,     0,     0,    68,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     5,    56,    58,    69,
+      60,    64,    65,    66,    67,     0,     0,     0,    18,    19,
+      20,    21,    22,    24,    25,    26,    27,    28,    40,     0,
+       0,     0,    39,    45,     0,    44,    31,    32,     0,     0,
+       0,     0,     0,     0,    38,     0,    35,    36,    37,    41,
+       0,     0,    46,     0,     0,     0,     0,     0,    43,    42,
+      48,    47
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+     -42,   -42,   -42,   207,   -42,   208,   -42,   -42,   -42,   -42,
+     -42,   -42,   -42,   -42,     7,   -11
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    46,    48,    54,    55,    56
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      58,    44,    59,    50,    51,    76,    45,   139,    50,    51,
+     143,   140,    50,    51,    92,    93,    94,    95,   112,    79,
+      92,    93,    94,    95,    92,    93,    94,    95,   141,   119,
+      92,    93,    94,    95,   162,    94,    95,    47,   163,    49,
+      77,    89,    90,    57,    78,   144,    52,   152,   153,    53,
+      60,    52,   166,   167,    53,    52,    61,    62,    53,    63,
+      64,    65,    66,    67,    68,    69,    70,   111,    71,    72,
+      73,    74,    75,    80,    83,    81,    82,    86,   110,    87,
+      88,   121,   122,   123,   124,    91,    96,   117,   118,    97,
+      98,    99,   125,   100,   126,   127,   101,   128,   120,   129,
+       1,   116,   145,     2,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,   -10,   102,   156,   157,   158,
+       1,   103,   104,     2,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
+      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,     2,     3,     4,     5,     6,
+       7,     8,     9,    10,    11,    12,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    32,    33,   105,   106,   107,
+     108,   130,   109,   113,   114,   115,   131,   132,   133,   134,
+     135,   136,   137,   138,   142,   146,   148,   147,   149,   150,
+     151,   154,   155,   159,   160,   161,   168,   169,   164,   165,
+     170,   171,    84,     0,     0,    85
+};
+
+static const yytype_int16 yycheck[] =
+{
+      11,    42,    13,     3,     4,     5,     4,    41,     3,     4,
+       5,    45,     3,     4,    45,    46,    47,    48,    43,    30,
+      45,    46,    47,    48,    45,    46,    47,    48,    43,    50,
+      45,    46,    47,    48,    41,    47,    48,     4,    45,     4,
+      40,    52,    53,     3,    44,    40,    46,     3,     4,    49,
+       5,    46,     3,     4,    49,    46,     5,     5,    49,     5,
+       5,     5,     5,     5,     5,     5,     5,    78,     5,     5,
+       5,     5,     5,     5,     0,     6,     5,    39,     5,    43,
+      43,    92,    93,    94,    95,    43,    43,     4,     4,    43,
+      43,    43,     5,    43,     5,     5,    43,     5,    91,     5,
+       4,    39,   113,     7,     8,     9,    10,    11,    12,    13,
+      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
+      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    43,   148,   149,   150,
+       4,    43,    43,     7,     8,     9,    10,    11,    12,    13,
+      14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
+      24,    25,    26,    27,    28,    29,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,     7,     8,     9,    10,    11,
+      12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
+      22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
+      32,    33,    34,    35,    36,    37,    38,    43,    43,    43,
+      43,     5,    43,    43,    43,    43,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,     5,    43,     6,    43,    43,
+      43,     5,     5,     5,    41,    41,     5,     5,    43,    43,
+      41,    41,    35,    -1,    -1,    37
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     4,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    42,     4,    63,     4,    64,     4,
+       3,     4,    46,    49,    65,    66,    67,     3,    67,    67,
+       5,     5,     5,     5,     5,     5,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,     5,     5,    40,    44,    67,
+       5,     6,     5,     0,    55,    57,    39,    43,    43,    67,
+      67,    43,    45,    46,    47,    48,    43,    43,    43,    43,
+      43,    43,    43,    43,    43,    43,    43,    43,    43,    43,
+       5,    67,    43,    43,    43,    43,    39,     4,     4,    50,
+      66,    67,    67,    67,    67,     5,     5,     5,     5,     5,
+       5,     5,     5,     5,     5,     5,     5,     5,     5,    41,
+      45,    43,     5,     5,    40,    67,     5,     6,    43,    43,
+      43,    43,     3,     4,     5,     5,    67,    67,    67,     5,
+      41,    41,    41,    45,    43,    43,     3,     4,     5,     5,
+      41,    41
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    52,    53,    54,    54,    55,    55,    56,    57,    57,
+      57,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    59,    59,    59,    59,    59,    60,    60,
+      60,    60,    60,    60,    61,    61,    61,    61,    61,    62,
+      62,    62,    62,    62,    62,    63,    63,    64,    64,    65,
+      65,    66,    67,    67,    67,    67,    67,    67,    67,    67
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     3,     2,     2,     1,     1,
+       0,     1,     1,     1,     1,     1,     2,     2,     4,     4,
+       4,     4,     4,     2,     4,     4,     4,     4,     4,     1,
+       1,     4,     4,     2,     2,     6,     6,     6,     5,     4,
+       4,     6,     8,     8,     4,     4,     6,     8,     8,     2,
+       2,     2,     2,     2,     1,     1,     3,     1,     3,     1,
+       3,     1,     1,     1,     3,     3,     3,     3,     2,     3
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (assembler, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, assembler, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, asm_core::Assembler& assembler, yyscan_t scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (assembler);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, asm_core::Assembler& assembler, yyscan_t scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep, assembler, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, asm_core::Assembler& assembler, yyscan_t scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], assembler, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, assembler, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+
+
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, asm_core::Assembler& assembler, yyscan_t scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (assembler);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (asm_core::Assembler& assembler, yyscan_t scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* program: lines  */
+#line 74 "misc/parser.y"
+                        { assembler.endAssembly(); }
+#line 1271 "misc/parser.cpp"
+    break;
+
+  case 5: /* line: label statement ENDL  */
+#line 82 "misc/parser.y"
+                              { assembler.nextLine(); }
+#line 1277 "misc/parser.cpp"
+    break;
+
+  case 6: /* line: statement ENDL  */
+#line 84 "misc/parser.y"
+                              { assembler.nextLine(); }
+#line 1283 "misc/parser.cpp"
+    break;
+
+  case 7: /* label: SYMBOL COLON  */
+#line 87 "misc/parser.y"
+                     { assembler.defineSymbol((yyvsp[-1].string)); }
+#line 1289 "misc/parser.cpp"
+    break;
+
+  case 11: /* instruction: HALT  */
+#line 97 "misc/parser.y"
+                    { assembler.insertInstruction(InstructionTypes::HALT, {}); }
+#line 1295 "misc/parser.cpp"
+    break;
+
+  case 12: /* instruction: INT  */
+#line 99 "misc/parser.y"
+                  { assembler.insertInstruction(InstructionTypes::INT, {});}
+#line 1301 "misc/parser.cpp"
+    break;
+
+  case 13: /* instruction: IRET  */
+#line 101 "misc/parser.y"
+                   { assembler.insertInstruction(InstructionTypes::IRET, {});}
+#line 1307 "misc/parser.cpp"
+    break;
+
+  case 15: /* instruction: RET  */
+#line 105 "misc/parser.y"
+                  { assembler.insertInstruction(InstructionTypes::RET, {});}
+#line 1313 "misc/parser.cpp"
+    break;
+
+  case 16: /* instruction: PUSH GPRX  */
+#line 107 "misc/parser.y"
+                        { assembler.insertInstruction(InstructionTypes::PUSH, {(yyvsp[0].character)}); }
+#line 1319 "misc/parser.cpp"
+    break;
+
+  case 17: /* instruction: POP GPRX  */
+#line 109 "misc/parser.y"
+                        { assembler.insertInstruction(InstructionTypes::POP, {(yyvsp[0].character)}); }
+#line 1325 "misc/parser.cpp"
+    break;
+
+  case 18: /* instruction: XCHG GPRX COMMA GPRX  */
+#line 111 "misc/parser.y"
+                                   { assembler.insertInstruction(InstructionTypes::XCHG, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1331 "misc/parser.cpp"
+    break;
+
+  case 19: /* instruction: ADD GPRX COMMA GPRX  */
+#line 113 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::ADD, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1337 "misc/parser.cpp"
+    break;
+
+  case 20: /* instruction: SUB GPRX COMMA GPRX  */
+#line 115 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::SUB, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1343 "misc/parser.cpp"
+    break;
+
+  case 21: /* instruction: MUL GPRX COMMA GPRX  */
+#line 117 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::MUL, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1349 "misc/parser.cpp"
+    break;
+
+  case 22: /* instruction: DIV GPRX COMMA GPRX  */
+#line 119 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::DIV, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1355 "misc/parser.cpp"
+    break;
+
+  case 23: /* instruction: NOT GPRX  */
+#line 121 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::NOT, {(yyvsp[0].character)}); }
+#line 1361 "misc/parser.cpp"
+    break;
+
+  case 24: /* instruction: AND GPRX COMMA GPRX  */
+#line 123 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::AND, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1367 "misc/parser.cpp"
+    break;
+
+  case 25: /* instruction: OR GPRX COMMA GPRX  */
+#line 125 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::OR, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1373 "misc/parser.cpp"
+    break;
+
+  case 26: /* instruction: XOR GPRX COMMA GPRX  */
+#line 127 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::XOR, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1379 "misc/parser.cpp"
+    break;
+
+  case 27: /* instruction: SHL GPRX COMMA GPRX  */
+#line 129 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::SHL, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1385 "misc/parser.cpp"
+    break;
+
+  case 28: /* instruction: SHR GPRX COMMA GPRX  */
+#line 131 "misc/parser.y"
+                                  { assembler.insertInstruction(InstructionTypes::SHR, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1391 "misc/parser.cpp"
+    break;
+
+  case 31: /* instruction: CSRRD CSRX COMMA GPRX  */
+#line 137 "misc/parser.y"
+                                    { assembler.insertInstruction(InstructionTypes::CSRRD, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1397 "misc/parser.cpp"
+    break;
+
+  case 32: /* instruction: CSRWR GPRX COMMA CSRX  */
+#line 139 "misc/parser.y"
+                                    { assembler.insertInstruction(InstructionTypes::CSRWR, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1403 "misc/parser.cpp"
+    break;
+
+  case 33: /* jumps: CALL expression  */
+#line 142 "misc/parser.y"
+                        { assembler.insertJumpInstructionExpression(InstructionTypes::CALL, 0, 0, (yyvsp[0].expression)); }
+#line 1409 "misc/parser.cpp"
+    break;
+
+  case 34: /* jumps: JMP expression  */
+#line 144 "misc/parser.y"
+                       { assembler.insertJumpInstructionExpression(InstructionTypes::JMP, 0, 0, (yyvsp[0].expression)); }
+#line 1415 "misc/parser.cpp"
+    break;
+
+  case 35: /* jumps: BEQ GPRX COMMA GPRX COMMA expression  */
+#line 146 "misc/parser.y"
+                                             { assembler.insertJumpInstructionExpression(InstructionTypes::BEQ, (yyvsp[-4].character), (yyvsp[-2].character), (yyvsp[0].expression)); }
+#line 1421 "misc/parser.cpp"
+    break;
+
+  case 36: /* jumps: BNE GPRX COMMA GPRX COMMA expression  */
+#line 148 "misc/parser.y"
+                                             { assembler.insertJumpInstructionExpression(InstructionTypes::BNE, (yyvsp[-4].character), (yyvsp[-2].character), (yyvsp[0].expression)); }
+#line 1427 "misc/parser.cpp"
+    break;
+
+  case 37: /* jumps: BGT GPRX COMMA GPRX COMMA expression  */
+#line 150 "misc/parser.y"
+                                             { assembler.insertJumpInstructionExpression(InstructionTypes::BGT, (yyvsp[-4].character), (yyvsp[-2].character), (yyvsp[0].expression)); }
+#line 1433 "misc/parser.cpp"
+    break;
+
+  case 38: /* load: LD DOLLAR expression COMMA GPRX  */
+#line 153 "misc/parser.y"
+                                      { assembler.insertLoadInstructionExpression(MemoryInstructionType::SYM_IMM, (yyvsp[-2].expression), (yyvsp[0].character)); }
+#line 1439 "misc/parser.cpp"
+    break;
+
+  case 39: /* load: LD expression COMMA GPRX  */
+#line 155 "misc/parser.y"
+                               { assembler.insertLoadInstructionExpression(MemoryInstructionType::SYM_MEM_DIR, (yyvsp[-2].expression), (yyvsp[0].character)); }
+#line 1445 "misc/parser.cpp"
+    break;
+
+  case 40: /* load: LD GPRX COMMA GPRX  */
+#line 157 "misc/parser.y"
+                          { assembler.insertLoadInstructionRegister(MemoryInstructionType::REG_IMM, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1451 "misc/parser.cpp"
+    break;
+
+  case 41: /* load: LD LBRACK GPRX RBRACK COMMA GPRX  */
+#line 159 "misc/parser.y"
+                                       { assembler.insertLoadInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {(yyvsp[-3].character), (yyvsp[0].character)}); }
+#line 1457 "misc/parser.cpp"
+    break;
+
+  case 43: /* load: LD LBRACK GPRX PLUS LITERAL RBRACK COMMA GPRX  */
+#line 163 "misc/parser.y"
+                                                    { assembler.insertLoadInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {(yyvsp[-5].character), (yyvsp[-3].number), (yyvsp[0].character)}); }
+#line 1463 "misc/parser.cpp"
+    break;
+
+  case 44: /* store: ST GPRX COMMA expression  */
+#line 166 "misc/parser.y"
+                                 { assembler.insertStoreInstructionExpression(MemoryInstructionType::SYM_MEM_DIR, (yyvsp[-2].character), (yyvsp[0].expression)); }
+#line 1469 "misc/parser.cpp"
+    break;
+
+  case 45: /* store: ST GPRX COMMA GPRX  */
+#line 168 "misc/parser.y"
+                           { assembler.insertStoreInstructionRegister(MemoryInstructionType::REG_IMM, {(yyvsp[-2].character), (yyvsp[0].character)}); }
+#line 1475 "misc/parser.cpp"
+    break;
+
+  case 46: /* store: ST GPRX COMMA LBRACK GPRX RBRACK  */
+#line 170 "misc/parser.y"
+                                         { assembler.insertStoreInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {(yyvsp[-4].character), (yyvsp[-1].character)}); }
+#line 1481 "misc/parser.cpp"
+    break;
+
+  case 48: /* store: ST GPRX COMMA LBRACK GPRX PLUS LITERAL RBRACK  */
+#line 174 "misc/parser.y"
+                                                      { assembler.insertStoreInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {(yyvsp[-6].character), (yyvsp[-3].character), (yyvsp[-1].number)}); }
+#line 1487 "misc/parser.cpp"
+    break;
+
+  case 51: /* directive: SECTION SYMBOL  */
+#line 181 "misc/parser.y"
+                            { assembler.openNewSection((yyvsp[0].string)); }
+#line 1493 "misc/parser.cpp"
+    break;
+
+  case 53: /* directive: SKIP LITERAL  */
+#line 185 "misc/parser.y"
+                            { assembler.insertBSS((yyvsp[0].number)); }
+#line 1499 "misc/parser.cpp"
+    break;
+
+  case 54: /* directive: END  */
+#line 187 "misc/parser.y"
+                { assembler.endAssembly(); YYACCEPT; }
+#line 1505 "misc/parser.cpp"
+    break;
+
+  case 55: /* global_symbol_list: SYMBOL  */
+#line 192 "misc/parser.y"
+                           { assembler.insertGlobalSymbol((yyvsp[0].string)); }
+#line 1511 "misc/parser.cpp"
+    break;
+
+  case 56: /* global_symbol_list: global_symbol_list COMMA SYMBOL  */
+#line 194 "misc/parser.y"
+                                                    { assembler.insertGlobalSymbol((yyvsp[0].string)); }
+#line 1517 "misc/parser.cpp"
+    break;
+
+  case 57: /* extern_symbol_list: SYMBOL  */
+#line 197 "misc/parser.y"
+                           { assembler.insertExternSymbol((yyvsp[0].string)); }
+#line 1523 "misc/parser.cpp"
+    break;
+
+  case 58: /* extern_symbol_list: extern_symbol_list COMMA SYMBOL  */
+#line 199 "misc/parser.y"
+                                                    { assembler.insertExternSymbol((yyvsp[0].string)); }
+#line 1529 "misc/parser.cpp"
+    break;
+
+  case 61: /* initializator: expression  */
+#line 208 "misc/parser.y"
+                           { assembler.insertWordExpression((yyvsp[0].expression)); }
+#line 1535 "misc/parser.cpp"
+    break;
+
+  case 62: /* expression: LITERAL  */
+#line 212 "misc/parser.y"
+                    { (yyval.expression) = assembler.makeLiteralExpression((yyvsp[0].number)); }
+#line 1541 "misc/parser.cpp"
+    break;
+
+  case 63: /* expression: SYMBOL  */
+#line 214 "misc/parser.y"
+                    { (yyval.expression) = assembler.makeSymbolExpression((yyvsp[0].string)); }
+#line 1547 "misc/parser.cpp"
+    break;
+
+  case 64: /* expression: expression PLUS expression  */
+#line 216 "misc/parser.y"
+                                        { (yyval.expression) = assembler.makeOperationExpression(ExpressionOperator::ADD, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 1553 "misc/parser.cpp"
+    break;
+
+  case 65: /* expression: expression MINUS expression  */
+#line 218 "misc/parser.y"
+                                        { (yyval.expression) = assembler.makeOperationExpression(ExpressionOperator::SUB, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 1559 "misc/parser.cpp"
+    break;
+
+  case 66: /* expression: expression STAR expression  */
+#line 220 "misc/parser.y"
+                                        { (yyval.expression) = assembler.makeOperationExpression(ExpressionOperator::MUL, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 1565 "misc/parser.cpp"
+    break;
+
+  case 67: /* expression: expression SLASH expression  */
+#line 222 "misc/parser.y"
+                                        { (yyval.expression) = assembler.makeOperationExpression(ExpressionOperator::DIV, (yyvsp[-2].expression), (yyvsp[0].expression)); }
+#line 1571 "misc/parser.cpp"
+    break;
+
+  case 68: /* expression: MINUS expression  */
+#line 224 "misc/parser.y"
+                                            { (yyval.expression) = assembler.makeOperationExpression(ExpressionOperator::NEG, (yyvsp[0].expression)); }
+#line 1577 "misc/parser.cpp"
+    break;
+
+  case 69: /* expression: LPAREN expression RPAREN  */
+#line 226 "misc/parser.y"
+                                     { (yyval.expression) = (yyvsp[-1].expression); }
+#line 1583 "misc/parser.cpp"
+    break;
+
+
+#line 1587 "misc/parser.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      yyerror (assembler, scanner, YY_("syntax error"));
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, assembler, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, assembler, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (assembler, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, assembler, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, assembler, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+
+  return yyresult;
+}
+
+#line 230 "misc/parser.y"
+
+
+void yyerror(asm_core::Assembler& assembler, yyscan_t scanner, const char* message)
+{
+  throw AssemblerError(ErrorCode::SYNTAX_ERROR, assembler.getSourceFileLine(),
+                       std::string("Greska na simbolu: ") + yyget_text(scanner));
+}
+
+// samo leksicka analiza celog ulaza (za -timing), vraca broj tokena
+uint64_t scanTokens(yyscan_t scanner)
+{
+  YYSTYPE value;
+  uint64_t numTokens = 0;
+  while(yylex(&value, scanner) != 0)
+  {
+    ++numTokens;
+  }
+
+  return numTokens;
+}
@@ -0,0 +1,151 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_MISC_PARSER_HPP_INCLUDED
+# define YY_YY_MISC_PARSER_HPP_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+/* "%code requires" blocks.  */
+#line 20 "misc/parser.y"
+
+  #include <cstdint>
+
+  namespace asm_core
+  {
+    class Assembler;
+  }
+
+  #ifndef YY_TYPEDEF_YY_SCANNER_T
+  #define YY_TYPEDEF_YY_SCANNER_T
+  typedef void* yyscan_t;
+  #endif
+
+#line 63 "misc/parser.hpp"
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    LITERAL = 258,                 /* LITERAL  */
+    SYMBOL = 259,                  /* SYMBOL  */
+    GPRX = 260,                    /* GPRX  */
+    CSRX = 261,                    /* CSRX  */
+    GLOBAL = 262,                  /* GLOBAL  */
+    EXTERN = 263,                  /* EXTERN  */
+    SECTION = 264,                 /* SECTION  */
+    WORD = 265,                    /* WORD  */
+    SKIP = 266,                    /* SKIP  */
+    END = 267,                     /* END  */
+    HALT = 268,                    /* HALT  */
+    INT = 269,                     /* INT  */
+    IRET = 270,                    /* IRET  */
+    CALL = 271,                    /* CALL  */
+    RET = 272,                     /* RET  */
+    JMP = 273,                     /* JMP  */
+    BEQ = 274,                     /* BEQ  */
+    BNE = 275,                     /* BNE  */
+    BGT = 276,                     /* BGT  */
+    PUSH = 277,                    /* PUSH  */
+    POP = 278,                     /* POP  */
+    XCHG = 279,                    /* XCHG  */
+    ADD = 280,                     /* ADD  */
+    SUB = 281,                     /* SUB  */
+    MUL = 282,                     /* MUL  */
+    DIV = 283,                     /* DIV  */
+    NOT = 284,                     /* NOT  */
+    AND = 285,                     /* AND  */
+    OR = 286,                      /* OR  */
+    XOR = 287,                     /* XOR  */
+    SHL = 288,                     /* SHL  */
+    SHR = 289,                     /* SHR  */
+    LD = 290,                      /* LD  */
+    ST = 291,                      /* ST  */
+    CSRRD = 292,                   /* CSRRD  */
+    CSRWR = 293,                   /* CSRWR  */
+    ENDL = 294,                    /* ENDL  */
+    LBRACK = 295,                  /* LBRACK  */
+    RBRACK = 296,                  /* RBRACK  */
+    COLON = 297,                   /* COLON  */
+    COMMA = 298,                   /* COMMA  */
+    DOLLAR = 299,                  /* DOLLAR  */
+    PLUS = 300,                    /* PLUS  */
+    MINUS = 301,                   /* MINUS  */
+    STAR = 302,                    /* STAR  */
+    SLASH = 303,                   /* SLASH  */
+    LPAREN = 304,                  /* LPAREN  */
+    RPAREN = 305,                  /* RPAREN  */
+    NEGATION = 306                 /* NEGATION  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 35 "misc/parser.y"
+
+  uint32_t number;
+  const char* string; /* ime iz bazena asemblera (Assembler::internName) */
+  uint8_t character;
+  uint32_t expression; /* indeks cvora izraza u asembleru (Assembler::makeLiteralExpression, ...) */
+
+#line 138 "misc/parser.hpp"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+
+
+int yyparse (asm_core::Assembler& assembler, yyscan_t scanner);
+
+
+#endif /* !YY_YY_MISC_PARSER_HPP_INCLUDED  */
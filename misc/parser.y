@@ -1,30 +1,42 @@
 %{
-  #include <assembler/assembler_common.hpp>
+  #include <assembler/assembler.hpp>
   #include <common/assembler_common_structures.hpp>
+  #include <common/exceptions.hpp>
 
   #include <iostream>
 
   using namespace common;
-
-  extern char* yytext;
-  extern int yylex();
-  extern int yyparse();
-  void yyerror(const char *s);
 %}
 
 %defines "misc/parser.hpp"
 %output "misc/parser.cpp"
 
+/* reentrantni parser: asembler i skener se prosledjuju kroz parametre, bez globalnog stanja */
+%define api.pure full
+%parse-param {asm_core::Assembler& assembler} {yyscan_t scanner}
+%lex-param {yyscan_t scanner}
+
 %code requires 
 {
   #include <cstdint>
+
+  namespace asm_core
+  {
+    class Assembler;
+  }
+
+  #ifndef YY_TYPEDEF_YY_SCANNER_T
+  #define YY_TYPEDEF_YY_SCANNER_T
+  typedef void* yyscan_t;
+  #endif
 }
 
 %union
 {
   uint32_t number;
-  char* string;
+  const char* string; /* ime iz bazena asemblera (Assembler::internName) */
   uint8_t character;
+  uint32_t expression; /* indeks cvora izraza u asembleru (Assembler::makeLiteralExpression, ...) */
 }
 
 %token <number> LITERAL
@@ -40,12 +52,26 @@
 %token LD ST CSRRD CSRWR /* Operacije sa registrima */
 %token ENDL
 %token LBRACK RBRACK COLON COMMA DOLLAR PLUS /* Specijalni znakovi */
+%token MINUS STAR SLASH LPAREN RPAREN /* Operatori u izrazima */
+
+%type <expression> expression
+
+%left PLUS MINUS
+%left STAR SLASH
+%precedence NEGATION
+
+%code
+{
+  int yylex(YYSTYPE* yylval, yyscan_t scanner);
+  void yyerror(asm_core::Assembler& assembler, yyscan_t scanner, const char* message);
+  char* yyget_text(yyscan_t scanner);
+}
 
 %start program
 
 %%
 
-program:  lines         { AssemblerCommon::assembler->endAssembly(); }
+program:  lines         { assembler.endAssembly(); }
           ;
 
 lines:  line
@@ -53,12 +79,12 @@ lines:  line
         lines line
         ;
 
-line:   label statement ENDL  { ++AssemblerCommon::currentSourceFileLine; }
+line:   label statement ENDL  { assembler.nextLine(); }
         |
-        statement ENDL        { ++AssemblerCommon::currentSourceFileLine; }
+        statement ENDL        { assembler.nextLine(); }
         ;
 
-label:  SYMBOL COLON { AssemblerCommon::assembler->defineSymbol($1); }
+label:  SYMBOL COLON { assembler.defineSymbol($1); }
         ;
 
 statement:  instruction
@@ -68,125 +94,109 @@ statement:  instruction
             /* EPSILON */
             ;
 
-instruction:  HALT  { AssemblerCommon::assembler->insertInstruction(InstructionTypes::HALT, {}); }
+instruction:  HALT  { assembler.insertInstruction(InstructionTypes::HALT, {}); }
               |
-              INT { AssemblerCommon::assembler->insertInstruction(InstructionTypes::INT, {});}
+              INT { assembler.insertInstruction(InstructionTypes::INT, {});}
               |
-              IRET { AssemblerCommon::assembler->insertInstruction(InstructionTypes::IRET, {});}
+              IRET { assembler.insertInstruction(InstructionTypes::IRET, {});}
               |
               jumps
               |
-              RET { AssemblerCommon::assembler->insertInstruction(InstructionTypes::RET, {});}
+              RET { assembler.insertInstruction(InstructionTypes::RET, {});}
               |
-              PUSH GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::PUSH, {$2}); }
+              PUSH GPRX { assembler.insertInstruction(InstructionTypes::PUSH, {$2}); }
               |
-              POP GPRX  { AssemblerCommon::assembler->insertInstruction(InstructionTypes::POP, {$2}); }
+              POP GPRX  { assembler.insertInstruction(InstructionTypes::POP, {$2}); }
               |
-              XCHG GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::XCHG, {$2, $4}); }
+              XCHG GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::XCHG, {$2, $4}); }
               |
-              ADD GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::ADD, {$2, $4}); }
+              ADD GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::ADD, {$2, $4}); }
               |
-              SUB GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::SUB, {$2, $4}); }
+              SUB GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::SUB, {$2, $4}); }
               |
-              MUL GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::MUL, {$2, $4}); }
+              MUL GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::MUL, {$2, $4}); }
               |
-              DIV GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::DIV, {$2, $4}); }
+              DIV GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::DIV, {$2, $4}); }
               |
-              NOT GPRX            { AssemblerCommon::assembler->insertInstruction(InstructionTypes::NOT, {$2}); }
+              NOT GPRX            { assembler.insertInstruction(InstructionTypes::NOT, {$2}); }
               |
-              AND GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::AND, {$2, $4}); }
+              AND GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::AND, {$2, $4}); }
               |
-              OR GPRX COMMA GPRX  { AssemblerCommon::assembler->insertInstruction(InstructionTypes::OR, {$2, $4}); }
+              OR GPRX COMMA GPRX  { assembler.insertInstruction(InstructionTypes::OR, {$2, $4}); }
               |
-              XOR GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::XOR, {$2, $4}); }
+              XOR GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::XOR, {$2, $4}); }
               |
-              SHL GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::SHL, {$2, $4}); }
+              SHL GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::SHL, {$2, $4}); }
               |
-              SHR GPRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::SHR, {$2, $4}); }
+              SHR GPRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::SHR, {$2, $4}); }
               |
               load
               |
               store
               |
-              CSRRD CSRX COMMA GPRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::CSRRD, {$2, $4}); }
+              CSRRD CSRX COMMA GPRX { assembler.insertInstruction(InstructionTypes::CSRRD, {$2, $4}); }
               |
-              CSRWR GPRX COMMA CSRX { AssemblerCommon::assembler->insertInstruction(InstructionTypes::CSRWR, {$2, $4}); }
+              CSRWR GPRX COMMA CSRX { assembler.insertInstruction(InstructionTypes::CSRWR, {$2, $4}); }
               ;
 
-jumps:  CALL LITERAL  { AssemblerCommon::assembler->insertJumpInstructionLiteral(InstructionTypes::CALL, {$2}); }
-        |
-        CALL SYMBOL { AssemblerCommon::assembler->insertJumpInstructionSymbol(InstructionTypes::CALL, {$2}); }
-        |
-        JMP LITERAL { AssemblerCommon::assembler->insertJumpInstructionLiteral(InstructionTypes::JMP, {$2}); }
-        |
-        JMP SYMBOL { AssemblerCommon::assembler->insertJumpInstructionSymbol(InstructionTypes::JMP, {$2}); }
+jumps:  CALL expression { assembler.insertJumpInstructionExpression(InstructionTypes::CALL, 0, 0, $2); }
         |
-        BEQ GPRX COMMA GPRX COMMA SYMBOL { AssemblerCommon::assembler->insertJumpInstructionSymbol(InstructionTypes::BEQ, {$2, $4, $6}); }
+        JMP expression { assembler.insertJumpInstructionExpression(InstructionTypes::JMP, 0, 0, $2); }
         |
-        BEQ GPRX COMMA GPRX COMMA LITERAL { AssemblerCommon::assembler->insertJumpInstructionLiteral(InstructionTypes::BEQ, {$2, $4, $6}); }
+        BEQ GPRX COMMA GPRX COMMA expression { assembler.insertJumpInstructionExpression(InstructionTypes::BEQ, $2, $4, $6); }
         |
-        BNE GPRX COMMA GPRX COMMA SYMBOL { AssemblerCommon::assembler->insertJumpInstructionSymbol(InstructionTypes::BNE, {$2, $4, $6}); }
+        BNE GPRX COMMA GPRX COMMA expression { assembler.insertJumpInstructionExpression(InstructionTypes::BNE, $2, $4, $6); }
         |
-        BNE GPRX COMMA GPRX COMMA LITERAL { AssemblerCommon::assembler->insertJumpInstructionLiteral(InstructionTypes::BNE, {$2, $4, $6}); }
-        |
-        BGT GPRX COMMA GPRX COMMA SYMBOL { AssemblerCommon::assembler->insertJumpInstructionSymbol(InstructionTypes::BGT, {$2, $4, $6}); }
-        |
-        BGT GPRX COMMA GPRX COMMA LITERAL { AssemblerCommon::assembler->insertJumpInstructionLiteral(InstructionTypes::BGT, {$2, $4, $6}); }
+        BGT GPRX COMMA GPRX COMMA expression { assembler.insertJumpInstructionExpression(InstructionTypes::BGT, $2, $4, $6); }
         ;
 
-load: LD DOLLAR SYMBOL COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionSymbol(MemoryInstructionType::SYM_IMM, {$3, $5}); }
-      |
-      LD DOLLAR LITERAL COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionLiteral(MemoryInstructionType::LIT_IMM, {$3, $5}); }
+load: LD DOLLAR expression COMMA GPRX { assembler.insertLoadInstructionExpression(MemoryInstructionType::SYM_IMM, $3, $5); }
       |
-      LD SYMBOL COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionSymbol(MemoryInstructionType::SYM_MEM_DIR, {$2, $4}); }
+      LD expression COMMA GPRX { assembler.insertLoadInstructionExpression(MemoryInstructionType::SYM_MEM_DIR, $2, $4); }
       |
-      LD LITERAL COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionLiteral(MemoryInstructionType::LIT_MEM_DIR, {$2, $4}); }
+      LD GPRX COMMA GPRX  { assembler.insertLoadInstructionRegister(MemoryInstructionType::REG_IMM, {$2, $4}); }
       |
-      LD GPRX COMMA GPRX  { AssemblerCommon::assembler->insertLoadInstructionRegister(MemoryInstructionType::REG_IMM, {$2, $4}); }
-      |
-      LD LBRACK GPRX RBRACK COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {$3, $6}); }
+      LD LBRACK GPRX RBRACK COMMA GPRX { assembler.insertLoadInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {$3, $6}); }
       |
       LD LBRACK GPRX PLUS SYMBOL RBRACK COMMA GPRX  /* NE MOZE DA SE DESI */
       |
-      LD LBRACK GPRX PLUS LITERAL RBRACK COMMA GPRX { AssemblerCommon::assembler->insertLoadInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {$3, $5, $8}); }
+      LD LBRACK GPRX PLUS LITERAL RBRACK COMMA GPRX { assembler.insertLoadInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {$3, $5, $8}); }
       ;
 
-store:  ST GPRX COMMA SYMBOL { AssemblerCommon::assembler->insertStoreInstructionSymbol(MemoryInstructionType::SYM_MEM_DIR, {$2, $4}); }
-        |
-        ST GPRX COMMA LITERAL { AssemblerCommon::assembler->insertStoreInstructionLiteral(MemoryInstructionType::LIT_MEM_DIR, {$2, $4}); }
+store:  ST GPRX COMMA expression { assembler.insertStoreInstructionExpression(MemoryInstructionType::SYM_MEM_DIR, $2, $4); }
         |
-        ST GPRX COMMA GPRX { AssemblerCommon::assembler->insertStoreInstructionRegister(MemoryInstructionType::REG_IMM, {$2, $4}); }
+        ST GPRX COMMA GPRX { assembler.insertStoreInstructionRegister(MemoryInstructionType::REG_IMM, {$2, $4}); }
         |
-        ST GPRX COMMA LBRACK GPRX RBRACK { AssemblerCommon::assembler->insertStoreInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {$2, $5}); }
+        ST GPRX COMMA LBRACK GPRX RBRACK { assembler.insertStoreInstructionRegister(MemoryInstructionType::REG_MEM_DIR, {$2, $5}); }
         |
         ST GPRX COMMA LBRACK GPRX PLUS SYMBOL RBRACK /* NE MOZE DA SE DESI */
         |
-        ST GPRX COMMA LBRACK GPRX PLUS LITERAL RBRACK { AssemblerCommon::assembler->insertStoreInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {$2, $5, $7}); }
+        ST GPRX COMMA LBRACK GPRX PLUS LITERAL RBRACK { assembler.insertStoreInstructionLiteral(MemoryInstructionType::REG_REL_LIT, {$2, $5, $7}); }
         ;
 
 directive:  GLOBAL global_symbol_list
             |
             EXTERN extern_symbol_list
             |
-            SECTION SYMBOL  { AssemblerCommon::assembler->openNewSection($2); }
+            SECTION SYMBOL  { assembler.openNewSection($2); }
             |
             WORD initializator_list
             |
-            SKIP LITERAL    { AssemblerCommon::assembler->insertBSS($2); }
+            SKIP LITERAL    { assembler.insertBSS($2); }
             |
-            END { AssemblerCommon::assembler->endAssembly(); YYACCEPT; }
+            END { assembler.endAssembly(); YYACCEPT; }
             ;
 
 
 
-global_symbol_list: SYMBOL { AssemblerCommon::assembler->insertGlobalSymbol($1); }
+global_symbol_list: SYMBOL { assembler.insertGlobalSymbol($1); }
                     |
-                    global_symbol_list COMMA SYMBOL { AssemblerCommon::assembler->insertGlobalSymbol($3); }
+                    global_symbol_list COMMA SYMBOL { assembler.insertGlobalSymbol($3); }
                     ;
 
-extern_symbol_list: SYMBOL { AssemblerCommon::assembler->insertExternSymbol($1); }
+extern_symbol_list: SYMBOL { assembler.insertExternSymbol($1); }
                     |
-                    extern_symbol_list COMMA SYMBOL { AssemblerCommon::assembler->insertExternSymbol($3); }
+                    extern_symbol_list COMMA SYMBOL { assembler.insertExternSymbol($3); }
                     ;
 
 initializator_list: initializator
@@ -195,16 +205,45 @@ initializator_list: initializator
                     ;
 
 
-initializator:  SYMBOL  { AssemblerCommon::assembler->insertSymbol($1); }
-                |
-                LITERAL { AssemblerCommon::assembler->insertLiteral($1); }
+initializator:  expression { assembler.insertWordExpression($1); }
                 ;
 
+/* izraz samo od literala asembler odmah racuna, ostali se racunaju na kraju asembliranja */
+expression: LITERAL { $$ = assembler.makeLiteralExpression($1); }
+            |
+            SYMBOL  { $$ = assembler.makeSymbolExpression($1); }
+            |
+            expression PLUS expression  { $$ = assembler.makeOperationExpression(ExpressionOperator::ADD, $1, $3); }
+            |
+            expression MINUS expression { $$ = assembler.makeOperationExpression(ExpressionOperator::SUB, $1, $3); }
+            |
+            expression STAR expression  { $$ = assembler.makeOperationExpression(ExpressionOperator::MUL, $1, $3); }
+            |
+            expression SLASH expression { $$ = assembler.makeOperationExpression(ExpressionOperator::DIV, $1, $3); }
+            |
+            MINUS expression %prec NEGATION { $$ = assembler.makeOperationExpression(ExpressionOperator::NEG, $2); }
+            |
+            LPAREN expression RPAREN { $$ = $2; }
+            ;
+
 
 %%
 
-void yyerror(const char* message)
+void yyerror(asm_core::Assembler& assembler, yyscan_t scanner, const char* message)
 {
-  uint32_t lineNum = AssemblerCommon::currentSourceFileLine;
-  std::cout << "Parserska greska na liniji " << lineNum << "! Greska na simbolu: " << yytext;
-}
\ No newline at end of file
+  throw AssemblerError(ErrorCode::SYNTAX_ERROR, assembler.getSourceFileLine(),
+                       std::string("Greska na simbolu: ") + yyget_text(scanner));
+}
+
+// samo leksicka analiza celog ulaza (za -timing), vraca broj tokena
+uint64_t scanTokens(yyscan_t scanner)
+{
+  YYSTYPE value;
+  uint64_t numTokens = 0;
+  while(yylex(&value, scanner) != 0)
+  {
+    ++numTokens;
+  }
+
+  return numTokens;
+}
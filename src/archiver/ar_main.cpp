@@ -0,0 +1,83 @@
+#include <common/archive_file_processor.hpp>
+#include <common/exceptions.hpp>
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace common;
+
+namespace
+{
+const char* USAGE = "Upotreba: ./archiver -o biblioteka.a ulaz1.o ulaz2.o ...\n"
+                    "          ./archiver -t biblioteka.a";
+
+void printArchive(const std::string& archiveFilePath)
+{
+  ArchiveIndex index = ArchiveFileProcessor::readIndex(archiveFilePath);
+
+  std::cout << "Clanovi:\n";
+  for(const ArchiveMember& member : index.members)
+  {
+    std::cout << "  " << member.name << " (" << member.size << " bajtova)\n";
+  }
+
+  std::map<std::string, uint32_t> sortedSymbols(index.symbolIndex.begin(), index.symbolIndex.end());
+  std::cout << "Simboli:\n";
+  for(const auto& [symbolName, memberIndex] : sortedSymbols)
+  {
+    std::cout << "  " << symbolName << " -> " << index.members[memberIndex].name << "\n";
+  }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    std::string outputFilePath;
+    std::vector<std::string> inputFilePaths;
+    int i = 1;
+    while(i < argc)
+    {
+      std::string argument = argv[i];
+
+      if(argument == "-t" && i + 1 < argc)
+      {
+        printArchive(argv[++i]);
+        return 0;
+      }
+      else if(argument == "-o")
+      {
+        if(outputFilePath.empty() && i + 1 < argc)
+        {
+          outputFilePath = argv[++i];
+        }
+        else
+        {
+          throw RuntimeError("Greska u -o opciji");
+        }
+      }
+      else
+      {
+        inputFilePaths.emplace_back(argument);
+      }
+
+      ++i;
+    }
+
+    if(outputFilePath.empty() || inputFilePaths.empty())
+    {
+      throw RuntimeError(USAGE);
+    }
+
+    ArchiveFileProcessor::writeToFile(inputFilePaths, outputFilePath);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return -1;
+  }
+}
@@ -1,48 +1,74 @@
-#include <assembler/assembler.hpp>
-#include <assembler/assembler_common.hpp>
-#include <common/exceptions.hpp>
+#include <assembler/assembler_driver.hpp>
+#include <assembler/assembly_cache.hpp>
 
-#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
-
-using namespace common;
-
-#define YYERROR_VERBOSE
-
-extern void yyerror(const char*);
-extern FILE *yyin;
-extern int yyparse();
+#include <vector>
 
 int main(int argc, char* argv[])
 {
-  std::string inputFilePath, outputFilePath;
-
 	try
 	{
-		if(argc != 4 || strcmp(argv[1], "-o") != 0) // program -o izlaz ulaz
+		asm_core::AssemblerCommand command = asm_core::parseAssemblerCommand(std::vector<std::string>(argv + 1, argv + argc));
+		const std::vector<asm_core::AssemblerJob>& jobs = command.jobs;
+		bool timing = command.timing;
+		std::unique_ptr<asm_core::AssemblyCache> cache;
+		if(!command.cacheDirectory.empty())
 		{
-			throw RuntimeError("Greska! Ispravna Sintaksa: ./assembler -o izlaz.o ulaz.s");
+			cache = std::make_unique<asm_core::AssemblyCache>(command.cacheDirectory);
 		}
 
-		outputFilePath = argv[2];
-		inputFilePath = argv[3];
-
-		AssemblerCommon::assembler = new asm_core::Assembler(outputFilePath);
-
-		FILE* inputFile = fopen(inputFilePath.c_str(), "rw+");
-		if(inputFile == nullptr)
+		bool hasErrors = false;
+		std::vector<asm_core::AssemblyTimes> times;
+		if(jobs.size() == 1)
+		{
+			times.resize(1);
+			try
+			{
+				asm_core::assembleFile(jobs[0].inputFilePath, jobs[0].outputFilePath, timing ? &times[0] : nullptr, cache.get());
+				if(timing)
+				{
+					asm_core::printAssemblyTimes(jobs[0].inputFilePath, times[0]);
+				}
+			}
+			catch(const std::exception& e)
+			{
+				std::cerr << e.what() << '\n';
+				hasErrors = true;
+			}
+		}
+		else
 		{
-			throw RuntimeError("Greska pri otvaranju ulaznog fajla " + inputFilePath + "!");
+			std::vector<std::string> errors = asm_core::assembleFiles(jobs, command.numThreads, timing ? &times : nullptr,
+			                                                          cache.get());
+			for(uint32_t i = 0; i < jobs.size(); ++i)
+			{
+				if(!errors[i].empty())
+				{
+					std::cerr << errors[i] << '\n';
+					hasErrors = true;
+				}
+				else if(timing)
+				{
+					asm_core::printAssemblyTimes(jobs[i].inputFilePath, times[i]);
+				}
+			}
 		}
 
-		yyin = inputFile;
-		yyparse();
+		if(cache != nullptr)
+		{
+			asm_core::AssemblyCacheStatistics totalStatistics = cache->recordStatistics();
+			if(command.printCacheStatistics)
+			{
+				cache->printStatistics(totalStatistics, std::cout);
+			}
+		}
+		return hasErrors ? -1 : 0;
 	}
 	catch(const std::exception& e)
 	{
 		std::cerr << e.what() << '\n';
 		return -1;
 	}
-	
-}
\ No newline at end of file
+}
@@ -1,10 +1,10 @@
 #include <assembler/assembler.hpp>
 #include <assembler/assembler_tables_printer.hpp>
 
-#include <assembler/assembler_common.hpp>
 #include <common/exceptions.hpp>
 #include <common/object_file_processor.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <iomanip>
@@ -18,6 +18,104 @@ constexpr int UNUSED_INT = -1;
 constexpr int WORD_SIZE = 4;
 constexpr uint32_t VALUE_OVERFLOW_LIMIT = (1 << 13);
 
+// vrednost izraza: konstanta + zbir koeficijent * adresa simbola. Simboli su sekcije i eksterni simboli,
+// definisani simbol je njegova sekcija uvecana za vrednost simbola
+struct LinearValue
+{
+  uint32_t constant = 0;
+  std::vector<std::pair<uint32_t, int32_t>> terms; // indeks u tabeli simbola i koeficijent, bez nultih koeficijenata
+};
+
+// delilac nije 0, deljenje je oznaceno
+uint32_t applyOperator(ExpressionOperator op, uint32_t left, uint32_t right)
+{
+  switch(op)
+  {
+    case ExpressionOperator::ADD:
+      return left + right;
+    case ExpressionOperator::SUB:
+      return left - right;
+    case ExpressionOperator::MUL:
+      return left * right;
+    case ExpressionOperator::DIV:
+      if(right == UINT32_MAX) // -1, INT32_MIN / -1 nije definisano
+      {
+        return 0 - left;
+      }
+      return static_cast<uint32_t>(static_cast<int32_t>(left) / static_cast<int32_t>(right));
+    case ExpressionOperator::NEG:
+      return 0 - left;
+    default:
+      return left;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+// left + sign * right
+LinearValue combine(const LinearValue& left, const LinearValue& right, int32_t sign)
+{
+  LinearValue result = left;
+  result.constant += sign > 0 ? right.constant : 0 - right.constant;
+  for(const auto& [reference, coefficient] : right.terms)
+  {
+    auto termIter = std::find_if(result.terms.begin(), result.terms.end(),
+                                 [reference = reference](const auto& term) { return term.first == reference; });
+    if(termIter == result.terms.end())
+    {
+      result.terms.emplace_back(reference, sign * coefficient);
+    }
+    else if((termIter->second += sign * coefficient) == 0) // npr. end - start u istoj sekciji
+    {
+      result.terms.erase(termIter);
+    }
+  }
+  return result;
+}
+//-----------------------------------------------------------------------------------------------------------
+LinearValue evaluateExpression(const std::vector<ExpressionNode>& expressions, const std::vector<Symbol>& symbolTable,
+                               uint32_t expression, uint32_t sourceFileLine)
+{
+  const ExpressionNode& node = expressions[expression];
+  switch(node.op)
+  {
+    case ExpressionOperator::LITERAL:
+      return {node.value, {}};
+    case ExpressionOperator::SYMBOL:
+    {
+      const Symbol& symbol = symbolTable[node.value];
+      if(symbol.sectionNumber == node.value || symbol.isExtern) // sekcija ili eksterni simbol
+      {
+        return {0, {{node.value, 1}}};
+      }
+      return {static_cast<uint32_t>(symbol.value), {{symbol.sectionNumber, 1}}};
+    }
+    case ExpressionOperator::NEG:
+      return combine({}, evaluateExpression(expressions, symbolTable, node.left, sourceFileLine), -1);
+    default:
+      break;
+  }
+
+  LinearValue left = evaluateExpression(expressions, symbolTable, node.left, sourceFileLine);
+  LinearValue right = evaluateExpression(expressions, symbolTable, node.right, sourceFileLine);
+  switch(node.op)
+  {
+    case ExpressionOperator::ADD:
+      return combine(left, right, 1);
+    case ExpressionOperator::SUB:
+      return combine(left, right, -1);
+    default: // MUL, DIV
+      if(!left.terms.empty() || !right.terms.empty())
+      {
+        throw AssemblerError(ErrorCode::EXPRESSION_ERROR, sourceFileLine,
+                             "Adrese simbola se u izrazu mogu samo sabirati i oduzimati.");
+      }
+      if(node.op == ExpressionOperator::DIV && right.constant == 0)
+      {
+        throw AssemblerError(ErrorCode::EXPRESSION_ERROR, sourceFileLine, "Deljenje nulom.");
+      }
+      return {applyOperator(node.op, left.constant, right.constant), {}};
+  }
+}
+
 } // unnamed
 
 namespace asm_core
@@ -30,13 +128,13 @@ Assembler::Assembler(const std::string& outputFilePath)
   symbolTable.emplace_back(undefinedSection);
 }
 //-----------------------------------------------------------------------------------------------------------
-void Assembler::insertGlobalSymbol(const std::string& symbolName)
+void Assembler::insertGlobalSymbol(std::string_view symbolName)
 {
   const uint32_t symbolIndex = findSymbol(symbolName);
   
   if(symbolIndex == INVALID) // nije u tabeli simbola
   {
-    symbolTable.emplace_back(symbolName, INVALID, 0, true, false, false, UNUSED);
+    insertNewSymbol(symbolName, INVALID, 0, true, false, false, UNUSED);
   }
   else // jeste u tabeli simbola
   {
@@ -44,20 +142,20 @@ void Assembler::insertGlobalSymbol(const std::string& symbolName)
     
     if(symbol.isExtern)
     {
-      throw AssemblerError(ErrorCode::GLOBAL_EXTERN_CONFLICT);
+      throw AssemblerError(ErrorCode::GLOBAL_EXTERN_CONFLICT, sourceFileLine);
     }
 
     symbol.isGlobal = true;
   }
 }
 //-----------------------------------------------------------------------------------------------------------
-void Assembler::insertExternSymbol(const std::string& symbolName)
+void Assembler::insertExternSymbol(std::string_view symbolName)
 {
   const uint32_t symbolIndex = findSymbol(symbolName);
 
   if(symbolIndex == INVALID) // nije u tabeli simbola
   {
-    symbolTable.emplace_back(symbolName, INVALID, INVALID, false, true, true, UNUSED);
+    insertNewSymbol(symbolName, INVALID, INVALID, false, true, true, UNUSED);
   }
   else // jeste u tabeli simbola
   {
@@ -65,30 +163,30 @@ void Assembler::insertExternSymbol(const std::string& symbolName)
 
     if(symbol.isDefined)
     {
-      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION);
+      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION, sourceFileLine);
     }
   }
 }
 //-----------------------------------------------------------------------------------------------------------
-void Assembler::defineSymbol(const std::string& symbolName)
+void Assembler::defineSymbol(std::string_view symbolName)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   uint32_t symbolIndex = findSymbol(symbolName);
 
   if(symbolIndex == INVALID) // nije u tabeli simbola
   {
-    symbolTable.emplace_back(symbolName, currentSectionNumber, locationCounter, false, false, true, UNUSED);
+    insertNewSymbol(symbolName, currentSectionNumber, locationCounter, false, false, true, UNUSED);
   }
   else // jeste u tabeli simbola
   {
     Symbol& symbol = symbolTable[symbolIndex];
     if(symbol.isDefined || symbol.isExtern)
     {
-      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION);
+      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION, sourceFileLine);
     }
     
     symbol.sectionNumber = currentSectionNumber;
@@ -97,7 +195,7 @@ void Assembler::defineSymbol(const std::string& symbolName)
   }
 }
 //-----------------------------------------------------------------------------------------------------------
-void Assembler::openNewSection(const std::string& sectionName)
+void Assembler::openNewSection(std::string_view sectionName)
 {
   const uint32_t symbolIndex = findSymbol(sectionName);
 
@@ -107,11 +205,11 @@ void Assembler::openNewSection(const std::string& sectionName)
 
     if(symbol.sectionNumber == symbolIndex) // redeklaracija sekcije
     {
-      throw AssemblerError(ErrorCode::SECTION_REDECLARATION);
+      throw AssemblerError(ErrorCode::SECTION_REDECLARATION, sourceFileLine);
     }
     else // konflikt simbola i sekcije
     {
-      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION);
+      throw AssemblerError(ErrorCode::SYMBOL_REDECLARATION, sourceFileLine);
     }
   }
   
@@ -119,28 +217,26 @@ void Assembler::openNewSection(const std::string& sectionName)
   closeCurrentSection();
 
   currentSectionNumber = symbolTable.size();
-  symbolTable.emplace_back(sectionName, currentSectionNumber, INVALID, false, false, false, 0);
+  insertNewSymbol(sectionName, currentSectionNumber, INVALID, false, false, false, 0);
 
 }
 //-----------------------------------------------------------------------------------------------------------
-void Assembler::insertSymbol(const std::string& symbolName)
+void Assembler::insertSymbol(std::string_view symbolName)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   uint32_t symbolIndex = findSymbol(symbolName);
   if(symbolIndex == INVALID) // nije u tabeli simbola
   {
-    symbolIndex = symbolTable.size();
-    symbolTable.emplace_back(symbolName, INVALID, INVALID, false, false, false, UNUSED);
+    symbolIndex = insertNewSymbol(symbolName, INVALID, INVALID, false, false, false, UNUSED);
   }
 
   // ubacujemo u niz koriscenja
-  Symbol& symbol = symbolTable[symbolIndex];
   AssemblerInstruction instruction {OperationCodes::WORD, 0, 0, 0, 0}; // simbol je cela rec pa nam je to jedino bitno
-  symbol.symbolUsages.emplace_back(instruction, currentSectionNumber, locationCounter);
+  addSymbolUsage(symbolIndex, instruction, locationCounter);
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
   sectionMemory.writeBSS(WORD_SIZE); // popunjavamo nulama, pa cemo u backpatchingu da popunimo vrednoscu simbola
@@ -152,7 +248,7 @@ void Assembler::insertLiteral(uint32_t value)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -165,7 +261,7 @@ void Assembler::insertBSS(uint32_t numBytes)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -178,7 +274,7 @@ void Assembler::insertInstruction(InstructionTypes instruction, const std::vecto
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -255,7 +351,7 @@ void Assembler::insertInstruction(InstructionTypes instruction, const std::vecto
       sectionMemory.writeInstruction({OperationCodes::LD_CSR_REG, pars[1], pars[0], 0, 0});
       break;
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
       break;
   }
 
@@ -266,7 +362,7 @@ void Assembler::insertLoadInstructionRegister(MemoryInstructionType instructionT
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -315,7 +411,7 @@ void Assembler::insertLoadInstructionRegister(MemoryInstructionType instructionT
       break;
     }
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
       break;
   }
 
@@ -326,7 +422,7 @@ void Assembler::insertLoadInstructionLiteral(MemoryInstructionType instructionTy
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -373,7 +469,7 @@ void Assembler::insertLoadInstructionLiteral(MemoryInstructionType instructionTy
       int offsetInt = static_cast<int>(offsetLit);
       if(std::abs(offsetInt) >= VALUE_OVERFLOW_LIMIT)
       {
-        throw AssemblerError(ErrorCode::VALUE_OVERFLOW);
+        throw AssemblerError(ErrorCode::VALUE_OVERFLOW, sourceFileLine);
       }
       uint16_t offset = static_cast<uint16_t>(offsetLit); // ne treba cuvanje u bazenu jer je garantovano manje od 12B
       sectionMemory.writeInstruction({OperationCodes::LD_REG_MEM_DIR, destReg, offsetReg, 0, offset});
@@ -382,7 +478,7 @@ void Assembler::insertLoadInstructionLiteral(MemoryInstructionType instructionTy
       break;
     }
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
       break;
   }
 
@@ -393,69 +489,26 @@ void Assembler::insertLoadInstructionSymbol(MemoryInstructionType instructionTyp
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
-  std::string symbolName = std::get<std::string>(parameters[0]);
+  std::string_view symbolName = std::get<std::string_view>(parameters[0]);
   uint8_t destReg = std::get<uint8_t>(parameters[1]); 
 
   uint32_t symbolIndex = findSymbol(symbolName);
   if(symbolIndex == INVALID) // ne nalazi se u tabeli simbola
   {
-    symbolIndex = symbolTable.size();
-    symbolTable.emplace_back(symbolName, INVALID, INVALID, false, false, false, UNUSED);
+    symbolIndex = insertNewSymbol(symbolName, INVALID, INVALID, false, false, false, UNUSED);
   }
 
-  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
-  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
-  std::vector<SymbolUsage>& usages = symbolTable[symbolIndex].symbolUsages;
-
-  // smestanje simbola u bazen literala ako vec nije tamo, ako jeste nadjemo gde se nalazi
-  // kada smestimo simbol u bazen tretiramo ga kao literal
-  uint32_t poolOffset = findPoolOffset(symbolIndex);
-  if(poolOffset == UINT32_MAX)
-  {
-    poolOffset = sectionMemory.writeLiteral(0); // pravimo praznu rec koju cemo posle popuniti
-    AssemblerInstruction instruction { OperationCodes::POOL, 0, 0, 0, 0 };
-    usages.emplace_back(instruction, currentSectionNumber, poolOffset); // po oc cemo znati da je offset za pool
-  }
-
-  size_t numInstructions = 0;
-  switch(instructionType)
-  {
-    case MemoryInstructionType::SYM_IMM:
-    {
-      AssemblerInstruction instruction {OperationCodes::LD_REG_MEM_DIR, destReg, PC, 0, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke 
-      
-      numInstructions = 1;
-      break;
-    }
-    case MemoryInstructionType::SYM_MEM_DIR:
-    {
-      AssemblerInstruction instruction {OperationCodes::LD_REG_MEM_DIR, destReg, PC, 0, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
-      
-      // u sledecoj instrukciji cemo imati vrednost simbola u registru i onda radimo load
-      sectionMemory.writeInstruction({OperationCodes::LD_REG_MEM_DIR, destReg, destReg, 0, 0});
-
-      numInstructions = 2;
-      break;
-    }
-    default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
-  }
-
-  locationCounter += WORD_SIZE * numInstructions;
+  writeLoadFromPool(instructionType, destReg, getSymbolPoolOffset(symbolIndex));
 }
 //-----------------------------------------------------------------------------------------------------------
 void Assembler::insertStoreInstructionRegister(MemoryInstructionType instructionType, const Parameters&& parameters)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -497,7 +550,7 @@ void Assembler::insertStoreInstructionRegister(MemoryInstructionType instruction
       break;
     }
     default:
-        throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+        throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
   }
 
   locationCounter += WORD_SIZE * numInstructions;
@@ -507,7 +560,7 @@ void Assembler::insertStoreInstructionLiteral(MemoryInstructionType instructionT
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -538,7 +591,7 @@ void Assembler::insertStoreInstructionLiteral(MemoryInstructionType instructionT
       int offsetInt = static_cast<int>(offsetLit);
       if(std::abs(offsetInt) >= VALUE_OVERFLOW_LIMIT)
       {
-        throw AssemblerError(ErrorCode::VALUE_OVERFLOW);
+        throw AssemblerError(ErrorCode::VALUE_OVERFLOW, sourceFileLine);
       }
       uint16_t offset = static_cast<uint16_t>(offsetLit); // ne treba cuvanje u bazenu jer je garantovano manje od 12B
       sectionMemory.writeInstruction({OperationCodes::ST_MEM_DIR, offsetReg, 0, srcReg, offset});
@@ -547,7 +600,7 @@ void Assembler::insertStoreInstructionLiteral(MemoryInstructionType instructionT
       break;
     }
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
       break;
   }
 
@@ -558,57 +611,26 @@ void Assembler::insertStoreInstructionSymbol(MemoryInstructionType instructionTy
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   uint8_t srcReg = std::get<uint8_t>(parameters[0]); 
-  std::string symbolName = std::get<std::string>(parameters[1]);
+  std::string_view symbolName = std::get<std::string_view>(parameters[1]);
 
   uint32_t symbolIndex = findSymbol(symbolName);
   if(symbolIndex == INVALID) // ne nalazi se u tabeli simbola
   {
-    symbolIndex = symbolTable.size();
-    symbolTable.emplace_back(symbolName, INVALID, INVALID, false, false, false, UNUSED);
+    symbolIndex = insertNewSymbol(symbolName, INVALID, INVALID, false, false, false, UNUSED);
   }
 
-  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
-  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
-  std::vector<SymbolUsage>& usages = symbolTable[symbolIndex].symbolUsages;
-
-  // smestanje simbola u bazen literala ako vec nije tamo, ako jeste nadjemo gde se nalazi
-  // kada smestimo simbol u bazen tretiramo ga kao literal
-  uint32_t poolOffset = findPoolOffset(symbolIndex);
-  if(poolOffset == UINT32_MAX)
-  {
-    poolOffset = sectionMemory.writeLiteral(0); // pravimo praznu rec koju cemo posle popuniti
-    AssemblerInstruction instruction { OperationCodes::POOL, 0, 0, 0, 0 };
-    usages.emplace_back(instruction, currentSectionNumber, poolOffset); // po oc cemo znati da je offset za pool
-  }
-
-  size_t numInstructions = 0;
-  switch(instructionType)
-  {
-    case MemoryInstructionType::SYM_MEM_DIR:
-    {
-      AssemblerInstruction instruction {OperationCodes::ST_MEM_IND, PC, 0, srcReg, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
-
-      numInstructions = 1;
-      break;
-    }
-    default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
-  }
-
-  locationCounter += WORD_SIZE * numInstructions;
+  writeStoreFromPool(instructionType, srcReg, getSymbolPoolOffset(symbolIndex));
 }
 //-----------------------------------------------------------------------------------------------------------
 void Assembler::insertJumpInstructionLiteral(InstructionTypes instructionType, const Parameters&& parameters)
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
   SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
@@ -684,7 +706,7 @@ void Assembler::insertJumpInstructionLiteral(InstructionTypes instructionType, c
     break;
   }
   default:
-    throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+    throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
   }
 
   locationCounter += WORD_SIZE * numInstructions;
@@ -694,108 +716,159 @@ void Assembler::insertJumpInstructionSymbol(InstructionTypes instructionType, co
 {
   if(currentSectionNumber == INVALID)
   {
-    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION);
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
   }
 
-  std::string symbolName;
+  std::string_view symbolName;
+  uint8_t regB = 0;
+  uint8_t regC = 0;
   switch(instructionType)
   {
     case InstructionTypes::CALL:
     case InstructionTypes::JMP:
-      symbolName = std::get<std::string>(parameters[0]);
+      symbolName = std::get<std::string_view>(parameters[0]);
       break;
     case InstructionTypes::BEQ:
     case InstructionTypes::BNE:
     case InstructionTypes::BGT:
-      symbolName = std::get<std::string>(parameters[2]);
+      regB = std::get<uint8_t>(parameters[0]);
+      regC = std::get<uint8_t>(parameters[1]);
+      symbolName = std::get<std::string_view>(parameters[2]);
       break;
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
   }
 
   uint32_t symbolIndex = findSymbol(symbolName);
   if(symbolIndex == INVALID) // ne nalazi se u tabeli simbola
   {
-    symbolIndex = symbolTable.size();
-    symbolTable.emplace_back(symbolName, INVALID, INVALID, false, false, false, UNUSED);
+    symbolIndex = insertNewSymbol(symbolName, INVALID, INVALID, false, false, false, UNUSED);
   }
 
-  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
-  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
-  std::vector<SymbolUsage>& usages = symbolTable[symbolIndex].symbolUsages;
-
-  // smestanje simbola u bazen literala ako vec nije tamo, ako jeste nadjemo gde se nalazi
-  // kada smestimo simbol u bazen tretiramo ga kao literal
-  uint32_t poolOffset = findPoolOffset(symbolIndex);
-  if(poolOffset == UINT32_MAX)
+  writeJumpFromPool(instructionType, regB, regC, getSymbolPoolOffset(symbolIndex));
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Assembler::makeLiteralExpression(uint32_t value)
+{
+  expressions.push_back({ExpressionOperator::LITERAL, value, 0, 0});
+  return expressions.size() - 1;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Assembler::makeSymbolExpression(std::string_view symbolName)
+{
+  uint32_t symbolIndex = findSymbol(symbolName);
+  if(symbolIndex == INVALID) // ne nalazi se u tabeli simbola
   {
-    poolOffset = sectionMemory.writeLiteral(0); // pravimo praznu rec koju cemo posle popuniti
-    AssemblerInstruction instruction { OperationCodes::POOL, 0, 0, 0, 0 };
-    usages.emplace_back(instruction, currentSectionNumber, poolOffset); // po oc cemo znati da je offset za pool
+    symbolIndex = insertNewSymbol(symbolName, INVALID, INVALID, false, false, false, UNUSED);
   }
 
-  size_t numInstructions = 0;
-  switch(instructionType)
+  expressions.push_back({ExpressionOperator::SYMBOL, symbolIndex, 0, 0});
+  return expressions.size() - 1;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Assembler::makeOperationExpression(ExpressionOperator op, uint32_t left, uint32_t right)
+{
+  // deo izraza bez simbola se racuna odmah, pa izraz samo od literala stize do instrukcije kao jedan literal
+  const ExpressionNode leftNode = expressions[left];
+  const ExpressionNode rightNode = expressions[op == ExpressionOperator::NEG ? left : right];
+  if(leftNode.op == ExpressionOperator::LITERAL && rightNode.op == ExpressionOperator::LITERAL)
   {
-    case InstructionTypes::CALL:
+    if(op == ExpressionOperator::DIV && rightNode.value == 0)
     {
-      AssemblerInstruction instruction {OperationCodes::CALL_REG_IND, PC, 0, 0, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
-
-      numInstructions = 1;
-      break;
+      throw AssemblerError(ErrorCode::EXPRESSION_ERROR, sourceFileLine, "Deljenje nulom.");
     }
-    case InstructionTypes::JMP:
-    {
-      AssemblerInstruction instruction {OperationCodes::JMP_MEM_DIR, PC, 0, 0, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+    return makeLiteralExpression(applyOperator(op, leftNode.value, rightNode.value));
+  }
 
-      numInstructions = 1;
+  expressions.push_back({op, 0, left, right});
+  return expressions.size() - 1;
+}
+//-----------------------------------------------------------------------------------------------------------
+// literal i sam simbol idu dosadasnjim putem, pa se za njih generise isti kod i iste relokacije kao ranije
+void Assembler::insertWordExpression(uint32_t expression)
+{
+  const ExpressionNode& node = expressions[expression];
+  switch(node.op)
+  {
+    case ExpressionOperator::LITERAL:
+      insertLiteral(node.value);
+      return;
+    case ExpressionOperator::SYMBOL:
+      insertSymbol(symbolTable[node.value].name);
+      return;
+    default:
       break;
-    }
-    case InstructionTypes::BEQ:
-    {
-      uint8_t regB = std::get<uint8_t>(parameters[0]);
-      uint8_t regC = std::get<uint8_t>(parameters[1]);
-
-      AssemblerInstruction instruction {OperationCodes::BEQ_MEM_DIR, PC, regB, regC, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+  }
 
-      numInstructions = 1;
-      break;
-    }
-    case InstructionTypes::BNE:
-    {
-      uint8_t regB = std::get<uint8_t>(parameters[0]);
-      uint8_t regC = std::get<uint8_t>(parameters[1]);
+  if(currentSectionNumber == INVALID)
+  {
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
+  }
 
-      AssemblerInstruction instruction {OperationCodes::BNE_MEM_DIR, PC, regB, regC, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+  expressionUsages.push_back({expression, OperationCodes::WORD, currentSectionNumber, locationCounter, sourceFileLine});
+  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+  sectionMemory.writeBSS(WORD_SIZE); // popunjavamo nulama, vrednost izraza se upisuje na kraju asembliranja
 
-      numInstructions = 1;
+  locationCounter += WORD_SIZE;
+}
+//-----------------------------------------------------------------------------------------------------------
+// instructionType je SYM_IMM ili SYM_MEM_DIR, za literal se koristi odgovarajuci LIT_ nacin adresiranja
+void Assembler::insertLoadInstructionExpression(MemoryInstructionType instructionType, uint32_t expression, uint8_t destReg)
+{
+  const ExpressionNode& node = expressions[expression];
+  switch(node.op)
+  {
+    case ExpressionOperator::LITERAL:
+      insertLoadInstructionLiteral(instructionType == MemoryInstructionType::SYM_IMM ? MemoryInstructionType::LIT_IMM
+                                                                                      : MemoryInstructionType::LIT_MEM_DIR,
+                                   {node.value, destReg});
       break;
-    }
-    case InstructionTypes::BGT:
+    case ExpressionOperator::SYMBOL:
+      insertLoadInstructionSymbol(instructionType, {std::string_view(symbolTable[node.value].name), destReg});
+      break;
+    default:
+      writeLoadFromPool(instructionType, destReg, getExpressionPoolOffset(expression));
+      break;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void Assembler::insertStoreInstructionExpression(MemoryInstructionType instructionType, uint8_t srcReg, uint32_t expression)
+{
+  const ExpressionNode& node = expressions[expression];
+  switch(node.op)
+  {
+    case ExpressionOperator::LITERAL:
+      insertStoreInstructionLiteral(MemoryInstructionType::LIT_MEM_DIR, {srcReg, node.value});
+      break;
+    case ExpressionOperator::SYMBOL:
+      insertStoreInstructionSymbol(instructionType, {srcReg, std::string_view(symbolTable[node.value].name)});
+      break;
+    default:
+      writeStoreFromPool(instructionType, srcReg, getExpressionPoolOffset(expression));
+      break;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void Assembler::insertJumpInstructionExpression(InstructionTypes instructionType, uint8_t regB, uint8_t regC,
+                                                uint32_t expression)
+{
+  const ExpressionNode& node = expressions[expression];
+  bool isBranch = instructionType != InstructionTypes::CALL && instructionType != InstructionTypes::JMP;
+  switch(node.op)
+  {
+    case ExpressionOperator::LITERAL:
+      insertJumpInstructionLiteral(instructionType, isBranch ? Parameters{regB, regC, node.value} : Parameters{node.value});
+      break;
+    case ExpressionOperator::SYMBOL:
     {
-      uint8_t regB = std::get<uint8_t>(parameters[0]);
-      uint8_t regC = std::get<uint8_t>(parameters[1]);
-
-      AssemblerInstruction instruction {OperationCodes::BGT_MEM_DIR, PC, regB, regC, 0};
-      poolPatches.push_back({instruction, poolOffset, locationCounter});
-      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
-
-      numInstructions = 1;
+      std::string_view symbolName = symbolTable[node.value].name;
+      insertJumpInstructionSymbol(instructionType, isBranch ? Parameters{regB, regC, symbolName} : Parameters{symbolName});
       break;
     }
     default:
-      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION);
+      writeJumpFromPool(instructionType, regB, regC, getExpressionPoolOffset(expression));
+      break;
   }
-
-  locationCounter += WORD_SIZE * numInstructions;
 }
 //-----------------------------------------------------------------------------------------------------------
 void Assembler::endAssembly()
@@ -805,32 +878,52 @@ void Assembler::endAssembly()
   validateSymbolTable();
 
   backpatch();
+  resolveExpressions();
   patchFromLiteralPool();
   createRelocationTables();
 
-  AssemblerOutputData data {symbolTable, sectionOrder, sectionMemoryMap, sectionRelocationMap};
-  ObjectFileProcessor::writeToFile(data, outputFilePath);
-  AssemblerTablesPrinter::printTables(data, outputFilePath);
+  // asembliranje je zavrseno, tabele se predaju bez kopiranja. Koriscenja simbola ostaju u areni asemblera
+  outputData = {std::move(symbolTable), std::move(sectionOrder),
+                std::move(sectionMemoryMap), std::move(sectionRelocationMap)};
+  if(!outputFilePath.empty())
+  {
+    ObjectFileProcessor::writeToFile(outputData, outputFilePath);
+    AssemblerTablesPrinter::printTables(outputData, outputFilePath);
+  }
 }
 //-----------------------------------------------------------------------------------------------------------
-uint32_t Assembler::findSymbol(const std::string& symbolName) const
+const char* Assembler::internName(std::string_view name)
 {
-  for(uint32_t i = 0, tableSize = symbolTable.size(); i < tableSize; ++i)
-  {
-    if(symbolTable[i].name == symbolName)
-    {
-      return i;
-    }
-  }
+  return namePool.intern(name).data();
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Assembler::findSymbol(std::string_view symbolName) const
+{
+  auto symbolIter = symbolIndexMap.find(symbolName);
+  return symbolIter == symbolIndexMap.end() ? INVALID : symbolIter->second;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Assembler::insertNewSymbol(std::string_view symbolName, uint32_t sectionNumber, int value,
+                                    bool isGlobal, bool isExtern, bool isDefined, uint32_t size)
+{
+  uint32_t symbolIndex = symbolTable.size();
+  symbolTable.emplace_back(std::string(symbolName), sectionNumber, value, isGlobal, isExtern, isDefined, size);
+  symbolIndexMap.emplace(namePool.intern(symbolName), symbolIndex);
 
-  return INVALID;
+  return symbolIndex;
+}
+//-----------------------------------------------------------------------------------------------------------
+void Assembler::addSymbolUsage(uint32_t symbolIndex, AssemblerInstruction instruction, uint32_t offset)
+{
+  symbolTable[symbolIndex].symbolUsages.append(usageArena.create(instruction, currentSectionNumber, offset));
 }
 //-----------------------------------------------------------------------------------------------------------
 uint32_t Assembler::findPoolOffset(uint32_t symbolIndex) const
 {
+  // bazen je po sekciji, rec iz bazena druge sekcije nije dostupna PC-relativnim pomerajem
   for(const SymbolUsage& usage : symbolTable[symbolIndex].symbolUsages)
   {
-    if(usage.instruction.oc == OperationCodes::POOL)
+    if(usage.instruction.oc == OperationCodes::POOL && usage.sectionNumber == currentSectionNumber)
     {
       return usage.offset;
     }
@@ -839,6 +932,125 @@ uint32_t Assembler::findPoolOffset(uint32_t symbolIndex) const
   return UINT32_MAX;
 }
 //-----------------------------------------------------------------------------------------------------------
+// smestanje simbola u bazen literala ako vec nije tamo, ako jeste nadjemo gde se nalazi
+// kada smestimo simbol u bazen tretiramo ga kao literal
+uint32_t Assembler::getSymbolPoolOffset(uint32_t symbolIndex)
+{
+  uint32_t poolOffset = findPoolOffset(symbolIndex);
+  if(poolOffset == UINT32_MAX)
+  {
+    SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+    poolOffset = sectionMemory.writeLiteral(0); // pravimo praznu rec koju cemo posle popuniti
+    AssemblerInstruction instruction { OperationCodes::POOL, 0, 0, 0, 0 };
+    addSymbolUsage(symbolIndex, instruction, poolOffset); // po oc cemo znati da je offset za pool
+  }
+
+  return poolOffset;
+}
+//-----------------------------------------------------------------------------------------------------------
+// svaki izraz dobija svoju rec u bazenu, popunjava se u resolveExpressions
+uint32_t Assembler::getExpressionPoolOffset(uint32_t expression)
+{
+  if(currentSectionNumber == INVALID)
+  {
+    throw AssemblerError(ErrorCode::INSTRUCTION_OUTSIDE_OF_SECTION, sourceFileLine);
+  }
+
+  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+  uint32_t poolOffset = sectionMemory.writeLiteral(0);
+  expressionUsages.push_back({expression, OperationCodes::POOL, currentSectionNumber, poolOffset, sourceFileLine});
+
+  return poolOffset;
+}
+//-----------------------------------------------------------------------------------------------------------
+void Assembler::writeLoadFromPool(MemoryInstructionType instructionType, uint8_t destReg, uint32_t poolOffset)
+{
+  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
+
+  size_t numInstructions = 0;
+  switch(instructionType)
+  {
+    case MemoryInstructionType::SYM_IMM:
+    {
+      AssemblerInstruction instruction {OperationCodes::LD_REG_MEM_DIR, destReg, PC, 0, 0};
+      poolPatches.push_back({instruction, poolOffset, locationCounter});
+      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke 
+      
+      numInstructions = 1;
+      break;
+    }
+    case MemoryInstructionType::SYM_MEM_DIR:
+    {
+      AssemblerInstruction instruction {OperationCodes::LD_REG_MEM_DIR, destReg, PC, 0, 0};
+      poolPatches.push_back({instruction, poolOffset, locationCounter});
+      sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+      
+      // u sledecoj instrukciji cemo imati vrednost simbola u registru i onda radimo load
+      sectionMemory.writeInstruction({OperationCodes::LD_REG_MEM_DIR, destReg, destReg, 0, 0});
+
+      numInstructions = 2;
+      break;
+    }
+    default:
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
+  }
+
+  locationCounter += WORD_SIZE * numInstructions;
+}
+//-----------------------------------------------------------------------------------------------------------
+void Assembler::writeStoreFromPool(MemoryInstructionType instructionType, uint8_t srcReg, uint32_t poolOffset)
+{
+  if(instructionType != MemoryInstructionType::SYM_MEM_DIR)
+  {
+    throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
+  }
+
+  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
+
+  AssemblerInstruction instruction {OperationCodes::ST_MEM_IND, PC, 0, srcReg, 0};
+  poolPatches.push_back({instruction, poolOffset, locationCounter});
+  sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+
+  locationCounter += WORD_SIZE;
+}
+//-----------------------------------------------------------------------------------------------------------
+// regB i regC se porede samo kod uslovnih skokova, za call i jmp su 0
+void Assembler::writeJumpFromPool(InstructionTypes instructionType, uint8_t regB, uint8_t regC, uint32_t poolOffset)
+{
+  OperationCodes oc;
+  switch(instructionType)
+  {
+    case InstructionTypes::CALL:
+      oc = OperationCodes::CALL_REG_IND;
+      break;
+    case InstructionTypes::JMP:
+      oc = OperationCodes::JMP_MEM_DIR;
+      break;
+    case InstructionTypes::BEQ:
+      oc = OperationCodes::BEQ_MEM_DIR;
+      break;
+    case InstructionTypes::BNE:
+      oc = OperationCodes::BNE_MEM_DIR;
+      break;
+    case InstructionTypes::BGT:
+      oc = OperationCodes::BGT_MEM_DIR;
+      break;
+    default:
+      throw AssemblerError(ErrorCode::UNRECOGNIZED_INSTRUCTION, sourceFileLine);
+  }
+
+  SectionMemory& sectionMemory = sectionMemoryMap[currentSectionNumber];
+  std::vector<LiteralPoolPatch>& poolPatches = sectionPoolPatchesMap[currentSectionNumber];
+
+  AssemblerInstruction instruction {oc, PC, regB, regC, 0};
+  poolPatches.push_back({instruction, poolOffset, locationCounter});
+  sectionMemory.writeBSS(4); // pravimo praznu instrukciju pa cemo je kasnije popuniti kad budemo imali podatke
+
+  locationCounter += WORD_SIZE;
+}
+//-----------------------------------------------------------------------------------------------------------
 void Assembler::closeCurrentSection()
 {
   if(currentSectionNumber == INVALID)
@@ -887,7 +1099,7 @@ void Assembler::patchFromLiteralPool()
       // pretpostavka da literal uvek ide u pomeraj (trenutno za svaku instrukciju).
       // smanjujemo za WORD_SIZE jer ce se do izvrsavanja PC povecati
       instruction.disp = (sectionMemory.getCodeSize() + poolPatch.poolOffset) - poolPatch.sectionOffset - WORD_SIZE;
-      sectionMemory.repairMemory(poolPatch.sectionOffset, SectionMemory::toMemorySegment(instruction));
+      sectionMemory.writeCode(poolPatch.sectionOffset, SectionMemory::toWord(instruction));
     }
   }
 }
@@ -916,18 +1128,54 @@ void Assembler::backpatch()
       switch(instruction.oc)
       {
         case OperationCodes::POOL:
-          sectionMemory.repairLiteralPool(usage.offset, SectionMemory::toMemorySegment(value));
+          sectionMemory.writeLiteralPool(usage.offset, value);
           break;
         case OperationCodes::WORD:
-          sectionMemory.repairMemory(usage.offset, SectionMemory::toMemorySegment(value));
+          sectionMemory.writeCode(usage.offset, value);
           break;
         default:
-          throw AssemblerError(ErrorCode::BACKPATCHING_ERROR);
+          throw AssemblerError(ErrorCode::BACKPATCHING_ERROR, sourceFileLine);
       }
     }
   }
 }
 //-----------------------------------------------------------------------------------------------------------
+/*
+Racuna izraze iz operanada kada su poznate vrednosti svih simbola. Vrednost mora biti:
+  - konstanta: samo se upisuje
+  - simbol (sekcija ili eksterni simbol) uvecan za konstantu: konstanta se upisuje, a relokacija ka simbolu
+    dodaje njegovu adresu pri linkovanju, kao za lokalne simbole (addend je vec u reci koju linker prepravlja)
+*/
+void Assembler::resolveExpressions()
+{
+  for(const ExpressionUsage& usage : expressionUsages)
+  {
+    LinearValue value = evaluateExpression(expressions, symbolTable, usage.expression, usage.sourceFileLine);
+    if(value.terms.size() > 1 || (value.terms.size() == 1 && value.terms[0].second != 1))
+    {
+      throw AssemblerError(ErrorCode::EXPRESSION_ERROR, usage.sourceFileLine,
+                           "Vrednost mora biti konstanta ili simbol uvecan za konstantu.");
+    }
+
+    SectionMemory& sectionMemory = sectionMemoryMap[usage.sectionNumber];
+    uint32_t offset = usage.offset;
+    if(usage.oc == OperationCodes::POOL)
+    {
+      sectionMemory.writeLiteralPool(usage.offset, value.constant);
+      offset = sectionMemory.getCodeSize() + usage.offset;
+    }
+    else
+    {
+      sectionMemory.writeCode(usage.offset, value.constant);
+    }
+
+    if(!value.terms.empty())
+    {
+      sectionRelocationMap[usage.sectionNumber].emplace_back(usage.oc, offset, value.terms[0].first);
+    }
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
 void Assembler::createRelocationTables()
 {
   for(int i = 1, tableSize = symbolTable.size(); i < tableSize; ++i)
@@ -952,6 +1200,16 @@ void Assembler::createRelocationTables()
       sectionRelocationMap[usage.sectionNumber].emplace_back(usage.instruction.oc, offset, symbolTableReference);
     }
   }
+
+  // linker prepravlja relokacije sortirane po offsetu
+  for(auto& [_, relocationEntries] : sectionRelocationMap)
+  {
+    std::sort(relocationEntries.begin(), relocationEntries.end(),
+      [](const RelocationEntry& entry1, const RelocationEntry& entry2)
+      {
+        return entry1.offset < entry2.offset;
+      });
+  }
 }
 
 } // namespace asm_core
\ No newline at end of file
@@ -1,9 +0,0 @@
-#include <assembler/assembler_common.hpp>
-
-namespace common
-{
-
-uint32_t AssemblerCommon::currentSourceFileLine = 1;
-asm_core::Assembler* AssemblerCommon::assembler = nullptr;
-
-} // namespace common
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include <assembler/assembler_driver.hpp>
+#include <assembler/assembler.hpp>
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+#include <common/thread_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+// reentrantni parser i skener iz misc/parser.y i misc/lexer.l
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+struct yy_buffer_state;
+int yylex_init_extra(asm_core::Assembler* assembler, yyscan_t* scanner);
+yy_buffer_state* yy_scan_buffer(char* base, size_t size, yyscan_t scanner);
+int yylex_destroy(yyscan_t scanner);
+int yyparse(asm_core::Assembler& assembler, yyscan_t scanner);
+uint64_t scanTokens(yyscan_t scanner);
+
+namespace
+{
+const char* const CACHE_DIRECTORY_VARIABLE = "ASSEMBLER_CACHE_DIR"; // kes bez -cache= opcije
+constexpr uint32_t SCAN_BUFFER_PADDING = 2; // flex zahteva dva YY_END_OF_BUFFER_CHAR (0) na kraju bafera
+
+uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+//-----------------------------------------------------------------------------------------------------------
+// ceo izvorni fajl jednim citanjem, sa dopunom koju trazi yy_scan_buffer
+std::vector<char> readSource(const std::string& inputFilePath, asm_core::AssemblyTimes* times)
+{
+  auto start = std::chrono::steady_clock::now();
+  std::ifstream inFile(inputFilePath, std::ios::binary | std::ios::ate);
+  if(!inFile.is_open())
+  {
+    throw common::RuntimeError("Greska pri otvaranju ulaznog fajla " + inputFilePath + "!");
+  }
+
+  std::streamsize size = inFile.tellg();
+  std::vector<char> source(size + SCAN_BUFFER_PADDING, '\0');
+  inFile.seekg(0);
+  if(!inFile.read(source.data(), size))
+  {
+    throw common::RuntimeError("Greska pri citanju ulaznog fajla " + inputFilePath + "!");
+  }
+
+  if(times != nullptr)
+  {
+    times->sourceBytes = size;
+    times->readMicroseconds = elapsedMicroseconds(start);
+  }
+  return source;
+}
+
+// skener cita direktno iz bafera u memoriji, bez kopiranja i bez stdio. Oslobadja se i kada parser baci izuzetak
+class ScannerGuard
+{
+public:
+  ScannerGuard(asm_core::Assembler& assembler, std::vector<char>& source)
+  {
+    if(yylex_init_extra(&assembler, &scanner) != 0)
+    {
+      throw common::RuntimeError("Greska pri pravljenju skenera!");
+    }
+    if(yy_scan_buffer(source.data(), source.size(), scanner) == nullptr)
+    {
+      yylex_destroy(scanner);
+      throw common::RuntimeError("Greska pri pravljenju bafera skenera!");
+    }
+  }
+  ~ScannerGuard()
+  {
+    yylex_destroy(scanner);
+  }
+
+  ScannerGuard(const ScannerGuard&) = delete;
+  ScannerGuard& operator=(const ScannerGuard&) = delete;
+
+  yyscan_t get() const { return scanner; }
+private:
+  yyscan_t scanner = nullptr;
+};
+//-----------------------------------------------------------------------------------------------------------
+void runAssembler(
+  asm_core::Assembler& assembler,
+  const std::string& inputFilePath,
+  std::vector<char>& source,
+  asm_core::AssemblyTimes* times)
+{
+  auto start = std::chrono::steady_clock::now();
+  if(times != nullptr)
+  {
+    // zaseban prolaz samo kroz skener, da bi se vreme leksicke analize odvojilo od parsiranja
+    try
+    {
+      ScannerGuard scanner(assembler, source);
+      scanTokens(scanner.get());
+    }
+    catch(const common::AssemblerError&) // prijavljuje se pri parsiranju, sa ispravnom linijom
+    {}
+    times->lexMicroseconds = elapsedMicroseconds(start);
+    start = std::chrono::steady_clock::now();
+  }
+
+  ScannerGuard scanner(assembler, source);
+  if(yyparse(assembler, scanner.get()) != 0)
+  {
+    throw common::RuntimeError("Greska pri parsiranju fajla " + inputFilePath + "!");
+  }
+
+  if(times != nullptr)
+  {
+    uint64_t totalMicroseconds = elapsedMicroseconds(start);
+    times->parseMicroseconds = totalMicroseconds - std::min(totalMicroseconds, times->lexMicroseconds);
+  }
+}
+
+} // namespace
+
+namespace asm_core
+{
+
+AssemblerCommand parseAssemblerCommand(const std::vector<std::string>& arguments)
+{
+  AssemblerCommand command;
+  for(size_t i = 0; i < arguments.size(); ++i)
+  {
+    const std::string& argument = arguments[i];
+    if(argument == "-timing")
+    {
+      command.timing = true;
+    }
+    else if(argument.compare(0, 9, "-threads=") == 0)
+    {
+      command.numThreads = std::strtoul(argument.c_str() + 9, nullptr, 0);
+    }
+    else if(argument.compare(0, 7, "-cache=") == 0 && argument.size() > 7)
+    {
+      command.cacheDirectory = argument.substr(7);
+    }
+    else if(argument == "-cache-stats")
+    {
+      command.printCacheStatistics = true;
+    }
+    else if(argument == "-o" && i + 2 < arguments.size())
+    {
+      command.jobs.push_back({arguments[i + 2], arguments[i + 1]});
+      i += 2;
+    }
+    else
+    {
+      command.jobs.clear();
+      break;
+    }
+  }
+
+  if(command.jobs.empty())
+  {
+    throw common::RuntimeError(
+      "Greska! Ispravna Sintaksa: ./assembler [-threads=n] [-timing] [-cache=direktorijum] [-cache-stats] "
+      "-o izlaz.o ulaz.s [-o izlaz2.o ulaz2.s ...]");
+  }
+
+  const char* cacheDirectory = std::getenv(CACHE_DIRECTORY_VARIABLE);
+  if(command.cacheDirectory.empty() && cacheDirectory != nullptr)
+  {
+    command.cacheDirectory = cacheDirectory;
+  }
+  return command;
+}
+//-----------------------------------------------------------------------------------------------------------
+void assembleFile(
+  const std::string& inputFilePath,
+  const std::string& outputFilePath,
+  AssemblyTimes* times,
+  AssemblyCache* cache)
+{
+  std::vector<char> source = readSource(inputFilePath, times);
+  std::string cacheKey;
+  if(cache != nullptr)
+  {
+    cacheKey = cache->getKey(std::string_view(source.data(), source.size() - SCAN_BUFFER_PADDING));
+    if(cache->fetch(cacheKey, outputFilePath))
+    {
+      return;
+    }
+  }
+
+  Assembler assembler(outputFilePath);
+  runAssembler(assembler, inputFilePath, source, times);
+  if(cache != nullptr)
+  {
+    cache->store(cacheKey, outputFilePath);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+lnk_core::LinkerInputData assembleToLinkerInput(
+  const std::string& inputFilePath,
+  const std::string& outputFilePath,
+  AssemblyTimes* times)
+{
+  std::vector<char> source = readSource(inputFilePath, times);
+  Assembler assembler(outputFilePath);
+  runAssembler(assembler, inputFilePath, source, times);
+  return common::ObjectFileProcessor::toLinkerInputData(std::move(assembler.getOutputData()));
+}
+//-----------------------------------------------------------------------------------------------------------
+std::vector<std::string> assembleFiles(
+  const std::vector<AssemblerJob>& jobs,
+  uint32_t numThreads,
+  std::vector<AssemblyTimes>* times,
+  AssemblyCache* cache)
+{
+  if(numThreads == 0)
+  {
+    numThreads = std::thread::hardware_concurrency();
+  }
+  numThreads = std::max<uint32_t>(1, std::min<uint32_t>(numThreads, jobs.size()));
+  if(times != nullptr)
+  {
+    times->assign(jobs.size(), {});
+  }
+
+  std::vector<std::string> errors(jobs.size());
+  common::ThreadPool threadPool(numThreads);
+  threadPool.parallelFor(jobs.size(), [&jobs, &errors, times, cache](uint32_t i)
+    {
+      try
+      {
+        assembleFile(jobs[i].inputFilePath, jobs[i].outputFilePath, times != nullptr ? &(*times)[i] : nullptr, cache);
+      }
+      catch(const std::exception& e)
+      {
+        errors[i] = jobs[i].inputFilePath + ": " + e.what();
+      }
+    });
+
+  return errors;
+}
+//-----------------------------------------------------------------------------------------------------------
+void printAssemblyTimes(const std::string& inputFilePath, const AssemblyTimes& times, std::ostream& out)
+{
+  auto toMegabytesPerSecond = [&times](uint64_t microseconds)
+  {
+    return microseconds == 0 ? 0.0 : static_cast<double>(times.sourceBytes) / microseconds;
+  };
+
+  out << std::dec << std::fixed << std::setprecision(2) << inputFilePath << ": " << times.sourceBytes
+      << " bajtova, citanje " << times.readMicroseconds << " us, leksicka analiza "
+      << times.lexMicroseconds << " us (" << toMegabytesPerSecond(times.lexMicroseconds)
+      << " MB/s), parsiranje i generisanje " << times.parseMicroseconds << " us ("
+      << toMegabytesPerSecond(times.parseMicroseconds) << " MB/s)\n";
+}
+
+} // namespace asm_core
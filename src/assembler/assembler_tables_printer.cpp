@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <sstream>
 
+using namespace common;
+
 namespace
 {
 
@@ -64,7 +66,7 @@ namespace asm_core
 
 void AssemblerTablesPrinter::printTables(const common::AssemblerOutputData& data, const std::string& filePath)
 {
-  std::string objDumpPath = replaceExtension(filePath, ".objdump");
+  std::string objDumpPath = getObjDumpPath(filePath);
   std::ofstream outFile(objDumpPath);
   if (!outFile.is_open()) 
   {
@@ -76,6 +78,11 @@ void AssemblerTablesPrinter::printTables(const common::AssemblerOutputData& data
   printGeneratedCode(data, outFile);
 }
 
+std::string AssemblerTablesPrinter::getObjDumpPath(const std::string& filePath)
+{
+  return replaceExtension(filePath, ".objdump");
+}
+
 void AssemblerTablesPrinter::printSymbolTable(const std::vector<common::Symbol>& symbolTable, std::ofstream& outFile)
 {
   std::string title = "SYMBOL TABLE";
@@ -0,0 +1,183 @@
+#include <assembler/assembly_cache.hpp>
+#include <assembler/assembler_tables_printer.hpp>
+
+#include <common/hash.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+using namespace common;
+
+namespace
+{
+// menja se kada se promeni izgled unosa kesa
+const std::string CACHE_FORMAT_VERSION = "asmcache-1";
+const char* const OBJECT_EXTENSION = ".o";
+const char* const OBJDUMP_EXTENSION = ".objdump";
+constexpr uint64_t SECOND_HASH_SEED = 0x9e3779b97f4a7c15ULL; // razlikuje pocetno stanje drugog hesa
+
+// izvrsni fajl odredjuje verziju asemblera: novi build menja velicinu ili vreme izmene, pa i sve kljuceve
+uint64_t getAssemblerIdentity()
+{
+  static const uint64_t identity = []()
+  {
+    uint64_t hash = fnv1a(CACHE_FORMAT_VERSION);
+    std::error_code errorCode;
+    std::filesystem::path executablePath = std::filesystem::read_symlink("/proc/self/exe", errorCode);
+    if(!errorCode)
+    {
+      uint64_t size = std::filesystem::file_size(executablePath, errorCode);
+      hash = fnv1a(errorCode ? 0 : size, hash);
+      auto writeTime = std::filesystem::last_write_time(executablePath, errorCode);
+      hash = fnv1a(errorCode ? 0 : static_cast<uint64_t>(writeTime.time_since_epoch().count()), hash);
+    }
+    return hash;
+  }();
+  return identity;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string toHex(uint64_t value)
+{
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+  return text;
+}
+//-----------------------------------------------------------------------------------------------------------
+// jedinstveno ime u okviru procesa i niti, da se istovremeni upisi istog unosa ne mesaju
+std::string getTemporaryPath(const std::string& filePath)
+{
+  return filePath + ".tmp." + std::to_string(getpid()) + "." +
+         std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+//-----------------------------------------------------------------------------------------------------------
+bool copyAtomically(const std::string& sourcePath, const std::string& destinationPath)
+{
+  std::string temporaryPath = getTemporaryPath(destinationPath);
+  std::error_code errorCode;
+  std::filesystem::copy_file(sourcePath, temporaryPath, std::filesystem::copy_options::overwrite_existing, errorCode);
+  if(!errorCode)
+  {
+    std::filesystem::rename(temporaryPath, destinationPath, errorCode);
+  }
+  if(errorCode)
+  {
+    std::filesystem::remove(temporaryPath, errorCode);
+    return false;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+bool copyFile(const std::string& sourcePath, const std::string& destinationPath)
+{
+  std::error_code errorCode;
+  std::filesystem::copy_file(sourcePath, destinationPath, std::filesystem::copy_options::overwrite_existing, errorCode);
+  return !errorCode;
+}
+
+} // namespace
+
+namespace asm_core
+{
+
+AssemblyCache::AssemblyCache(const std::string& directory) : directory(directory)
+{
+  std::error_code errorCode;
+  std::filesystem::create_directories(directory, errorCode);
+}
+//-----------------------------------------------------------------------------------------------------------
+// dva FNV-1a stanja sa razlicitim pocetkom u jednom prolazu kroz izvor
+std::string AssemblyCache::getKey(std::string_view source) const
+{
+  uint64_t identity = getAssemblerIdentity();
+  uint64_t sourceSize = source.size();
+  uint64_t hash1 = fnv1a(sourceSize, identity);
+  uint64_t hash2 = fnv1a(sourceSize, identity ^ SECOND_HASH_SEED);
+  for(unsigned char byte : source)
+  {
+    hash1 = (hash1 ^ byte) * FNV_PRIME;
+    hash2 = (hash2 ^ byte) * FNV_PRIME;
+  }
+  return toHex(hash1) + toHex(hash2);
+}
+//-----------------------------------------------------------------------------------------------------------
+bool AssemblyCache::fetch(const std::string& key, const std::string& outputFilePath)
+{
+  // redosled kao pri asembliranju: tabele se upisuju posle objektnog fajla
+  bool isHit = copyFile(getEntryPath(key, OBJECT_EXTENSION), outputFilePath) &&
+               copyFile(getEntryPath(key, OBJDUMP_EXTENSION), AssemblerTablesPrinter::getObjDumpPath(outputFilePath));
+  ++(isHit ? numHits : numMisses);
+  return isHit;
+}
+//-----------------------------------------------------------------------------------------------------------
+// objektni fajl se upisuje poslednji, pa postojanje .o znaci da je unos potpun
+void AssemblyCache::store(const std::string& key, const std::string& outputFilePath)
+{
+  std::error_code errorCode;
+  std::filesystem::create_directories(std::filesystem::path(directory) / key.substr(0, 2), errorCode);
+  if(!errorCode &&
+     copyAtomically(AssemblerTablesPrinter::getObjDumpPath(outputFilePath), getEntryPath(key, OBJDUMP_EXTENSION)))
+  {
+    copyAtomically(outputFilePath, getEntryPath(key, OBJECT_EXTENSION));
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+// fajl statistike se menja pod zakljucavanjem, jer ga dele svi procesi koji koriste kes
+AssemblyCacheStatistics AssemblyCache::recordStatistics()
+{
+  AssemblyCacheStatistics statistics = getStatistics();
+  AssemblyCacheStatistics totalStatistics;
+  int statsFd = open((std::filesystem::path(directory) / "stats").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(statsFd < 0)
+  {
+    return statistics;
+  }
+
+  if(flock(statsFd, LOCK_EX) != 0)
+  {
+    close(statsFd);
+    return statistics;
+  }
+
+  char text[64] = {};
+  ssize_t numRead = pread(statsFd, text, sizeof(text) - 1, 0);
+  unsigned long long hits = 0;
+  unsigned long long misses = 0;
+  if(numRead > 0 && std::sscanf(text, "%llu %llu", &hits, &misses) == 2)
+  {
+    totalStatistics = {hits, misses};
+  }
+  totalStatistics.hits += statistics.hits - recordedStatistics.hits;
+  totalStatistics.misses += statistics.misses - recordedStatistics.misses;
+
+  int size = std::snprintf(text, sizeof(text), "%llu %llu\n", static_cast<unsigned long long>(totalStatistics.hits),
+                           static_cast<unsigned long long>(totalStatistics.misses));
+  if(ftruncate(statsFd, 0) == 0 && pwrite(statsFd, text, size, 0) == size)
+  {
+    recordedStatistics = statistics;
+  }
+  flock(statsFd, LOCK_UN);
+  close(statsFd);
+
+  return totalStatistics;
+}
+//-----------------------------------------------------------------------------------------------------------
+void AssemblyCache::printStatistics(const AssemblyCacheStatistics& totalStatistics, std::ostream& out) const
+{
+  AssemblyCacheStatistics statistics = getStatistics();
+  out << std::dec << "Kes asemblera " << directory << ": pogodaka " << statistics.hits << ", promasaja "
+      << statistics.misses << " (ukupno pogodaka " << totalStatistics.hits << ", promasaja "
+      << totalStatistics.misses << ")\n";
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string AssemblyCache::getEntryPath(const std::string& key, const char* extension) const
+{
+  return (std::filesystem::path(directory) / key.substr(0, 2) / (key + extension)).string();
+}
+
+} // namespace asm_core
@@ -0,0 +1,177 @@
+#include <common/archive_file_processor.hpp>
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+const std::string ARCHIVE_MAGIC = "!archive";
+const std::string MEMBER_PREFIX = "Member:";
+const std::string SYMBOL_PREFIX = "Symbol:";
+const std::string DATA_LINE = "Data:";
+
+std::vector<std::string> splitLine(const std::string& line)
+{
+  std::istringstream lineStream(line);
+  std::string token;
+  std::vector<std::string> tokens;
+
+  while(std::getline(lineStream, token, ':'))
+  {
+    tokens.push_back(token);
+  }
+
+  return tokens;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string toMemberName(const std::string& filePath)
+{
+  size_t separatorPos = filePath.find_last_of('/');
+  return separatorPos == std::string::npos ? filePath : filePath.substr(separatorPos + 1);
+}
+
+} // namespace
+
+namespace common
+{
+
+void ArchiveFileProcessor::writeToFile(const std::vector<std::string>& memberFilePaths, const std::string& archiveFilePath)
+{
+  std::vector<std::string> memberContents;
+  std::vector<ArchiveMember> members;
+  std::vector<std::pair<std::string, uint32_t>> symbols; // redosled clanova, zbog deterministickog izlaza
+  std::unordered_map<std::string, uint32_t> symbolIndex;
+
+  uint64_t offset = 0;
+  for(uint32_t memberIndex = 0, numMembers = memberFilePaths.size(); memberIndex < numMembers; ++memberIndex)
+  {
+    const std::string& memberFilePath = memberFilePaths[memberIndex];
+    std::ifstream memberFile(memberFilePath);
+    if(!memberFile.is_open())
+    {
+      throw RuntimeError("Fajl na putanji " + memberFilePath + " nije mogao biti otvoren!");
+    }
+    std::stringstream content;
+    content << memberFile.rdbuf();
+    memberContents.push_back(content.str());
+
+    lnk_core::LinkerInputData data = ObjectFileProcessor::readFromBuffer(memberContents.back());
+    for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      if(symbol.sectionNumber == i || symbol.isExtern || !symbol.isGlobal) // samo izvezeni simboli
+      {
+        continue;
+      }
+      if(!symbolIndex.emplace(symbol.name, memberIndex).second)
+      {
+        throw RuntimeError("Simbol " + symbol.name + " je definisan u vise clanova arhive!");
+      }
+      symbols.emplace_back(symbol.name, memberIndex);
+    }
+
+    members.push_back({toMemberName(memberFilePath), offset, memberContents.back().size()});
+    offset += memberContents.back().size();
+  }
+
+  std::ofstream outFile(archiveFilePath, std::ios::binary);
+  if(!outFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + archiveFilePath + " nije mogao biti otvoren!");
+  }
+
+  outFile << ARCHIVE_MAGIC << "\n";
+  for(const ArchiveMember& member : members)
+  {
+    outFile << MEMBER_PREFIX << member.name << ":" << member.offset << ":" << member.size << "\n";
+  }
+  for(const auto& [symbolName, memberIndex] : symbols)
+  {
+    outFile << SYMBOL_PREFIX << symbolName << ":" << memberIndex << "\n";
+  }
+  outFile << DATA_LINE << "\n";
+  for(const std::string& content : memberContents)
+  {
+    outFile << content;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+bool ArchiveFileProcessor::isArchive(const std::string& filePath)
+{
+  std::ifstream inFile(filePath);
+  std::string line;
+  return std::getline(inFile, line) && line == ARCHIVE_MAGIC;
+}
+//-----------------------------------------------------------------------------------------------------------
+// cita samo zaglavlje, clanovi ostaju na disku
+ArchiveIndex ArchiveFileProcessor::readIndex(const std::string& archiveFilePath)
+{
+  std::ifstream inFile(archiveFilePath, std::ios::binary);
+  if(!inFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + archiveFilePath + " nije mogao biti otvoren!");
+  }
+
+  ArchiveIndex index;
+  index.filePath = archiveFilePath;
+
+  std::string line;
+  if(!std::getline(inFile, line) || line != ARCHIVE_MAGIC)
+  {
+    throw RuntimeError("Fajl " + archiveFilePath + " nije arhiva!");
+  }
+
+  while(std::getline(inFile, line) && line != DATA_LINE)
+  {
+    std::vector<std::string> tokens = splitLine(line);
+    if(line.compare(0, MEMBER_PREFIX.size(), MEMBER_PREFIX) == 0 && tokens.size() == 4)
+    {
+      index.members.push_back({tokens[1], std::stoull(tokens[2]), std::stoull(tokens[3])});
+    }
+    else if(line.compare(0, SYMBOL_PREFIX.size(), SYMBOL_PREFIX) == 0 && tokens.size() == 3)
+    {
+      uint32_t memberIndex = std::stoul(tokens[2]);
+      if(memberIndex >= index.members.size())
+      {
+        throw RuntimeError("Nevazeci indeks clana u arhivi " + archiveFilePath + ": " + line);
+      }
+      index.symbolIndex.emplace(tokens[1], memberIndex);
+    }
+    else
+    {
+      throw RuntimeError("Nevazeci format linije arhive " + line);
+    }
+  }
+
+  if(line != DATA_LINE)
+  {
+    throw RuntimeError("Arhiva " + archiveFilePath + " nema deo sa podacima!");
+  }
+  index.dataOffset = inFile.tellg();
+
+  return index;
+}
+//-----------------------------------------------------------------------------------------------------------
+lnk_core::LinkerInputData ArchiveFileProcessor::readMember(const ArchiveIndex& index, uint32_t memberIndex)
+{
+  const ArchiveMember& member = index.members.at(memberIndex);
+
+  std::ifstream inFile(index.filePath, std::ios::binary);
+  if(!inFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + index.filePath + " nije mogao biti otvoren!");
+  }
+
+  std::string content(member.size, '\0');
+  inFile.seekg(index.dataOffset + member.offset);
+  if(!inFile.read(content.data(), member.size))
+  {
+    throw RuntimeError("Clan " + member.name + " arhive " + index.filePath + " nije mogao biti procitan!");
+  }
+
+  return ObjectFileProcessor::readFromBuffer(content);
+}
+
+} // namespace common
@@ -0,0 +1,42 @@
+#include <common/arena.hpp>
+
+#include <cstring>
+
+namespace common
+{
+
+std::string_view StringPool::intern(std::string_view text)
+{
+  auto stringIter = strings.find(text);
+  if(stringIter != strings.end())
+  {
+    return *stringIter;
+  }
+
+  char* copy = allocate(text.size() + 1);
+  std::memcpy(copy, text.data(), text.size());
+  copy[text.size()] = '\0';
+
+  return *strings.emplace(copy, text.size()).first;
+}
+//-----------------------------------------------------------------------------------------------------------
+char* StringPool::allocate(size_t size)
+{
+  if(size > CHUNK_SIZE) // dugacak string dobija sopstveni blok, tekuci blok ostaje otvoren
+  {
+    largeStrings.push_back(std::make_unique<char[]>(size));
+    return largeStrings.back().get();
+  }
+
+  if(chunkUsed + size > CHUNK_SIZE)
+  {
+    chunks.push_back(std::make_unique<char[]>(CHUNK_SIZE));
+    chunkUsed = 0;
+  }
+
+  char* memory = chunks.back().get() + chunkUsed;
+  chunkUsed += size;
+  return memory;
+}
+
+} // namespace common
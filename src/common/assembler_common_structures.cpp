@@ -6,33 +6,46 @@
 namespace common
 {
 
+namespace
+{
+
+uint32_t loadWord(const uint8_t* bytes)
+{
+  return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+         static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+//-----------------------------------------------------------------------------------------------------------
+void storeWord(uint8_t* bytes, uint32_t value)
+{
+  bytes[0] = value & 0xFF;
+  bytes[1] = (value >> 8) & 0xFF;
+  bytes[2] = (value >> 16) & 0xFF;
+  bytes[3] = (value >> 24) & 0xFF;
+}
+//-----------------------------------------------------------------------------------------------------------
+void appendWord(std::vector<uint8_t>& segment, uint32_t value)
+{
+  segment.resize(segment.size() + sizeof(value));
+  storeWord(segment.data() + segment.size() - sizeof(value), value);
+}
+
+} // namespace
+
 // section memory
 //-----------------------------------------------------------------------------------------------------------
 void SectionMemory::writeInstruction(AssemblerInstruction instruction)
 {
-  const MemorySegment& memorySegment = toMemorySegment(instruction);
-
-  for(int i = 0; i < 4; ++i)
-  {
-    code.emplace_back(memorySegment[i]);
-  }
+  appendWord(code, toWord(instruction));
 }
 //-----------------------------------------------------------------------------------------------------------
 void SectionMemory::writeWord(uint32_t instruction)
 {
-  uint8_t* bytes = reinterpret_cast<uint8_t*>(&instruction);
-  for(int i = 0, numBytes = sizeof(instruction); i < numBytes; ++i)
-  {
-    code.emplace_back(bytes[i]);
-  }
+  appendWord(code, instruction);
 }
 //-----------------------------------------------------------------------------------------------------------
 void SectionMemory::writeBSS(uint32_t numBytes)
 {
-  for(uint32_t i = 0; i < numBytes; ++i)
-  {
-    code.emplace_back(0);
-  }
+  code.resize(code.size() + numBytes, 0);
 }
 //-----------------------------------------------------------------------------------------------------------
 void SectionMemory::writeBytes(const MemorySegment& bytes)
@@ -43,56 +56,62 @@ void SectionMemory::writeBytes(const MemorySegment& bytes)
 uint32_t SectionMemory::writeLiteral(uint32_t literal)
 {
   uint32_t location = literalPool.size();
-  uint8_t* bytes = reinterpret_cast<uint8_t*>(&literal);
-  for(int i = 0, numBytes = sizeof(literal); i < numBytes; ++i)
-  {
-    literalPool.emplace_back(bytes[i]);
-  }
+  appendWord(literalPool, literal);
 
   return location;
 }
 //-----------------------------------------------------------------------------------------------------------
 uint32_t SectionMemory::readCode(uint32_t address) const
 {
-  if(address + 4 > code.size())
-  {
-    std::string message = "address=" + std::to_string(address) + ", codeSize=" + std::to_string(code.size());
-    throw common::MemoryError("SectionMemory::readCode", message);
-  }
-  uint32_t value = 0;
-  value |= code[address];
-  value |= static_cast<uint32_t>(code[address + 1]) << 8;
-  value |= static_cast<uint32_t>(code[address + 2]) << 16;
-  value |= static_cast<uint32_t>(code[address + 3]) << 24;
-
-  return value;
+  checkWordAddress(code.size(), address, "SectionMemory::readCode");
+  return loadWord(code.data() + address);
+}
+//-----------------------------------------------------------------------------------------------------------
+void SectionMemory::writeCode(uint32_t address, uint32_t value)
+{
+  checkWordAddress(code.size(), address, "SectionMemory::writeCode");
+  storeWord(code.data() + address, value);
+}
+//-----------------------------------------------------------------------------------------------------------
+void SectionMemory::writeLiteralPool(uint32_t address, uint32_t value)
+{
+  checkWordAddress(literalPool.size(), address, "SectionMemory::writeLiteralPool");
+  storeWord(literalPool.data() + address, value);
 }
 //-----------------------------------------------------------------------------------------------------------
 void SectionMemory::addToAddress(uint32_t address, uint32_t value)
 {
-  uint32_t memoryValue = readCode(address);
-  repairMemory(address, toMemorySegment(memoryValue + value));
+  checkWordAddress(code.size(), address, "SectionMemory::addToAddress");
+  uint8_t* bytes = code.data() + address;
+  storeWord(bytes, loadWord(bytes) + value);
+}
+//-----------------------------------------------------------------------------------------------------------
+void SectionMemory::addToAddresses(const WordPatch* begin, const WordPatch* end)
+{
+  addToWords(code.data(), code.size(), begin, end);
 }
 //-----------------------------------------------------------------------------------------------------------
-void SectionMemory::repairMemory(uint32_t start, MemorySegment repairBytes)
+// zakrpe su sortirane po adresi, pa je dovoljno proveriti granicu poslednje
+void SectionMemory::addToWords(uint8_t* buffer, uint32_t bufferSize, const WordPatch* begin, const WordPatch* end)
 {
-  if(start + repairBytes.size() > code.size())
+  if(begin == end)
   {
-    std::string message = "address=" + std::to_string(start) + ", codeSize=" + std::to_string(code.size());
-    throw common::MemoryError("SectionMemory::repairMemory", message);
+    return;
   }
+  checkWordAddress(bufferSize, (end - 1)->address, "SectionMemory::addToWords");
 
-  for(int i = 0, repairSize = repairBytes.size(); i < repairSize; ++i)
+  for(const WordPatch* patch = begin; patch != end; ++patch)
   {
-    code[start + i] = repairBytes[i];
+    storeWord(buffer + patch->address, loadWord(buffer + patch->address) + patch->value);
   }
 }
 //-----------------------------------------------------------------------------------------------------------
-void SectionMemory::repairLiteralPool(uint32_t start, MemorySegment repairBytes)
+void SectionMemory::checkWordAddress(uint32_t bufferSize, uint32_t address, const char* methodName)
 {
-  for(int i = 0, repairSize = repairBytes.size(); i < repairSize; ++i)
+  if(static_cast<uint64_t>(address) + 4 > bufferSize)
   {
-    literalPool[start + i] = repairBytes[i];
+    std::string message = "address=" + std::to_string(address) + ", size=" + std::to_string(bufferSize);
+    throw common::MemoryError(methodName, message);
   }
 }
 //-----------------------------------------------------------------------------------------------------------
@@ -106,30 +125,14 @@ SectionMemory::MemorySegment SectionMemory::getSectionMemory() const
   return sectionMemory;
 }
 //-----------------------------------------------------------------------------------------------------------
-SectionMemory::MemorySegment SectionMemory::toMemorySegment(uint32_t value)
+// little-endian: disp[7:0], regC | disp[11:8], regA | regB, oc
+uint32_t SectionMemory::toWord(AssemblerInstruction instruction)
 {
-  MemorySegment memorySegment;
-  uint8_t* bytes = reinterpret_cast<uint8_t*>(&value);
-
-  for(int i = 0, numBytes = sizeof(value); i < numBytes; ++i)
-  {
-    memorySegment.emplace_back(bytes[i]);
-  }
-
-  return memorySegment;
-}
-
-SectionMemory::MemorySegment SectionMemory::toMemorySegment(AssemblerInstruction instruction)
-{
-  MemorySegment memorySegment;
-  // little-endian format
-  memorySegment.emplace_back((instruction.disp & 0x00FF));
-  memorySegment.emplace_back(((instruction.regC & 0x0F) << 4) | ((instruction.disp & 0x0F00) >> 8));
-  memorySegment.emplace_back(((instruction.regA & 0x0F) << 4) | (instruction.regB & 0x0F));
-  memorySegment.emplace_back(static_cast<uint8_t>(instruction.oc));
-
-  return memorySegment;
+  return static_cast<uint32_t>(instruction.oc) << 24 |
+         static_cast<uint32_t>(instruction.regA & 0x0F) << 20 |
+         static_cast<uint32_t>(instruction.regB & 0x0F) << 16 |
+         static_cast<uint32_t>(instruction.regC & 0x0F) << 12 |
+         (instruction.disp & 0x0FFF);
 }
 
 } // namespace common
-
@@ -1,93 +1,365 @@
 #include <common/executable_file_processor.hpp>
 #include <common/exceptions.hpp>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstdint>
-#include <iomanip>
-#include <iostream>
+#include <cstring>
 #include <fstream>
+#include <string_view>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HEX_DECODER_SSSE3
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr uint32_t BYTES_PER_LINE = 8;
+constexpr uint32_t ADDRESS_DIGITS = 8;
+constexpr uint32_t BYTES_OFFSET = ADDRESS_DIGITS + 2; // "aaaaaaaa: "
+constexpr uint32_t FULL_LINE_LENGTH = BYTES_OFFSET + 3 * BYTES_PER_LINE; // bez '\n'
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+// "xx " za svaku vrednost bajta
+const std::array<std::array<char, 3>, 256> HEX_BYTE_TEXTS = []()
+{
+  std::array<std::array<char, 3>, 256> byteTexts{};
+  for(uint32_t value = 0; value < 256; ++value)
+  {
+    byteTexts[value] = {HEX_DIGITS[value >> 4], HEX_DIGITS[value & 0xF], ' '};
+  }
+  return byteTexts;
+}();
+
+[[noreturn]] void throwFormatError(const char* lineBegin, const char* lineEnd)
+{
+  throw common::RuntimeError("Nevazeci format linije " + std::string(lineBegin, lineEnd));
+}
+//-----------------------------------------------------------------------------------------------------------
+int hexDigitValue(char character)
+{
+  if(character >= '0' && character <= '9')
+  {
+    return character - '0';
+  }
+  character |= 0x20; // i velika slova
+  if(character >= 'a' && character <= 'f')
+  {
+    return character - 'a' + 10;
+  }
+  return -1;
+}
+//-----------------------------------------------------------------------------------------------------------
+bool isSpace(char character)
+{
+  return character == ' ' || character == '\t' || character == '\r';
+}
+
+// red koji je linker upisao pun: "aaaaaaaa: " i osam puta "xx "
+bool isFullLine(const char* lineBegin, const char* lineEnd)
+{
+  if(lineEnd - lineBegin != FULL_LINE_LENGTH || lineBegin[ADDRESS_DIGITS] != ':')
+  {
+    return false;
+  }
+  for(uint32_t position = ADDRESS_DIGITS + 1; position < FULL_LINE_LENGTH; position += 3)
+  {
+    if(lineBegin[position] != ' ')
+    {
+      return false;
+    }
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+// bajtovi reda proizvoljnog oblika: heksadecimalni brojevi od jedne ili dve cifre razdvojeni belinama.
+// Bez izlaza samo broji bajtove
+uint32_t decodeBytesScalar(const char* lineBegin, const char* bytesBegin, const char* lineEnd, uint8_t* output)
+{
+  uint32_t numBytes = 0;
+  const char* current = bytesBegin;
+  while(true)
+  {
+    while(current != lineEnd && isSpace(*current))
+    {
+      ++current;
+    }
+    if(current == lineEnd)
+    {
+      return numBytes;
+    }
+
+    int highDigit = hexDigitValue(*current++);
+    int value = highDigit;
+    if(current != lineEnd && !isSpace(*current))
+    {
+      int lowDigit = hexDigitValue(*current++);
+      value = highDigit * 16 + lowDigit;
+      if(lowDigit < 0 || (current != lineEnd && !isSpace(*current)))
+      {
+        throwFormatError(lineBegin, lineEnd);
+      }
+    }
+    if(highDigit < 0)
+    {
+      throwFormatError(lineBegin, lineEnd);
+    }
+
+    if(output != nullptr)
+    {
+      output[numBytes] = static_cast<uint8_t>(value);
+    }
+    ++numBytes;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+bool decodeFullLineScalar(const char* bytesBegin, uint8_t* output)
+{
+  for(uint32_t i = 0; i < BYTES_PER_LINE; ++i)
+  {
+    int highDigit = hexDigitValue(bytesBegin[3 * i]);
+    int lowDigit = hexDigitValue(bytesBegin[3 * i + 1]);
+    if(highDigit < 0 || lowDigit < 0)
+    {
+      return false;
+    }
+    output[i] = static_cast<uint8_t>(highDigit * 16 + lowDigit);
+  }
+  return true;
+}
+
+#ifdef HEX_DECODER_SSSE3
+// 16 heksadecimalnih cifara punog reda se skupljaju u jedan registar (pshufb), pretvaraju u nibl-ove i
+// spajaju u 8 bajtova (pmaddubsw, packuswb). Citanje ne prelazi kraj reda: poslednje ucitavanje pocinje 16
+// znakova pre kraja dela sa bajtovima
+__attribute__((target("ssse3")))
+bool decodeFullLineSsse3(const char* bytesBegin, uint8_t* output)
+{
+  const __m128i lowChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytesBegin));
+  const __m128i highChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytesBegin + 8));
+  const __m128i lowShuffle = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 12, 13, 15, -1, -1, -1, -1, -1);
+  const __m128i highShuffle = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 8, 10, 11, 13, 14);
+  const __m128i digits = _mm_or_si128(_mm_shuffle_epi8(lowChars, lowShuffle), _mm_shuffle_epi8(highChars, highShuffle));
+
+  const __m128i decimalValues = _mm_sub_epi8(digits, _mm_set1_epi8('0'));
+  const __m128i isDecimal = _mm_cmpeq_epi8(_mm_min_epu8(decimalValues, _mm_set1_epi8(9)), decimalValues);
+  const __m128i letterValues = _mm_sub_epi8(_mm_or_si128(digits, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letterValues, _mm_set1_epi8(5)), letterValues);
+  if(_mm_movemask_epi8(_mm_or_si128(isDecimal, isLetter)) != 0xFFFF)
+  {
+    return false;
+  }
+
+  const __m128i nibbles = _mm_or_si128(_mm_and_si128(isDecimal, decimalValues),
+                                       _mm_and_si128(isLetter, _mm_add_epi8(letterValues, _mm_set1_epi8(10))));
+  const __m128i values = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110)); // visi nibl * 16 + nizi nibl
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(values, values));
+  return true;
+}
+
+const bool HAS_SSSE3 = __builtin_cpu_supports("ssse3");
+#endif
+
+bool decodeFullLine(const char* bytesBegin, uint8_t* output)
+{
+#ifdef HEX_DECODER_SSSE3
+  if(HAS_SSSE3)
+  {
+    return decodeFullLineSsse3(bytesBegin, output);
+  }
+#endif
+  return decodeFullLineScalar(bytesBegin, output);
+}
+
+// redovi izvrsnog fajla bez praznih redova, sa procitanom adresom
+class HexLineReader
+{
+public:
+  explicit HexLineReader(std::string_view text)
+    : position(text.data()), end(text.data() + text.size()) {}
+
+  bool nextLine()
+  {
+    do
+    {
+      if(position == end)
+      {
+        return false;
+      }
+      lineBegin = position;
+      lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+      if(lineEnd == nullptr)
+      {
+        lineEnd = end;
+      }
+      position = lineEnd == end ? end : lineEnd + 1;
+    } while(lineBegin == lineEnd);
+
+    const char* colon = static_cast<const char*>(std::memchr(lineBegin, ':', lineEnd - lineBegin));
+    if(colon == nullptr)
+    {
+      throwFormatError(lineBegin, lineEnd);
+    }
+    const char* addressBegin = std::find_if_not(lineBegin, colon, isSpace);
+    auto [addressEnd, errorCode] = std::from_chars(addressBegin, colon, address, 16);
+    if(errorCode != std::errc() || addressEnd != colon)
+    {
+      throwFormatError(lineBegin, lineEnd);
+    }
+    bytesBegin = colon + 1;
+    isFull = isFullLine(lineBegin, lineEnd);
+    return true;
+  }
+
+  uint32_t getAddress() const { return address; }
+
+  uint32_t countBytes() const
+  {
+    return isFull ? BYTES_PER_LINE : decodeBytesScalar(lineBegin, bytesBegin, lineEnd, nullptr);
+  }
+
+  // vraca broj upisanih bajtova
+  uint32_t decodeBytes(uint8_t* output) const
+  {
+    if(!isFull)
+    {
+      return decodeBytesScalar(lineBegin, bytesBegin, lineEnd, output);
+    }
+    if(!decodeFullLine(lineBegin + BYTES_OFFSET, output))
+    {
+      throwFormatError(lineBegin, lineEnd);
+    }
+    return BYTES_PER_LINE;
+  }
+private:
+  const char* position;
+  const char* end;
+  const char* lineBegin = nullptr;
+  const char* lineEnd = nullptr;
+  const char* bytesBegin = nullptr;
+  uint32_t address = 0;
+  bool isFull = false;
+};
+
+} // namespace
 
 namespace common
 {
 
-void ExecutableFileProcessor::writeToFile(
-  const std::vector<GlobalSectionData> globalSectionData, 
-  const std::string& outputFilePath)
+void ExecutableFileProcessor::writeToFile(const std::vector<OutputSegment>& segments, const std::string& outputFilePath)
 {
-  std::ofstream outFile(outputFilePath);
+  std::ofstream outFile(outputFilePath, std::ios::binary);
   if(!outFile.is_open())
   {
     throw common::RuntimeError("Fajl na putanji " + outputFilePath + " nije mogao biti otvoren!");
   }
 
-  for(const auto& data : globalSectionData)
+  // redovi se slazu u bafer koji se upisuje u vecim blokovima
+  std::string buffer;
+  buffer.reserve(FLUSH_THRESHOLD + FULL_LINE_LENGTH + 1);
+  auto flush = [&buffer, &outFile, &outputFilePath]()
   {
-    uint32_t startAddress = data.startAddress, size = data.size;
-    const auto& code = data.generatedCode.getCode();
-    if(size != code.size())
+    if(!outFile.write(buffer.data(), buffer.size()))
     {
-      throw common::LinkerError("Greska u velicini generisanog koda!");
+      throw common::RuntimeError("Greska pri upisu u fajl " + outputFilePath + "!");
     }
+    buffer.clear();
+  };
+
+  for(const OutputSegment& segment : segments)
+  {
+    uint32_t startAddress = segment.startAddress, size = segment.size;
+    const uint8_t* code = segment.bytes;
 
     uint32_t address = startAddress;
-    for (size_t i = 0; i < size; i += 8)
+    for (size_t i = 0; i < size; i += BYTES_PER_LINE)
     {
-        outFile << std::setfill('0') << std::setw(8) << std::hex << address << ": ";
-        for (size_t j = 0; j < 8 && (i + j) < code.size(); ++j)
-        {
-          outFile << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(code[i + j]) << " ";
-        }
+      char line[FULL_LINE_LENGTH + 1];
+      for(uint32_t digit = 0; digit < ADDRESS_DIGITS; ++digit)
+      {
+        line[digit] = HEX_DIGITS[(address >> (28 - 4 * digit)) & 0xF];
+      }
+      line[ADDRESS_DIGITS] = ':';
+      line[ADDRESS_DIGITS + 1] = ' ';
 
-        outFile << "\n";
-        address += 8;
-    }
+      char* lineEnd = line + BYTES_OFFSET;
+      for (size_t j = 0; j < BYTES_PER_LINE && (i + j) < size; ++j)
+      {
+        std::memcpy(lineEnd, HEX_BYTE_TEXTS[code[i + j]].data(), 3);
+        lineEnd += 3;
+      }
+      *lineEnd++ = '\n';
+      buffer.append(line, lineEnd);
 
+      if(buffer.size() >= FLUSH_THRESHOLD)
+      {
+        flush();
+      }
+      address += BYTES_PER_LINE;
+    }
   }
+  flush();
 }
 //---------------------------------------------------------------------------------------------------------------------
 emulator_core::CodeSegments ExecutableFileProcessor::readFromFile(const std::string& inputFilePath)
 {
-  std::ifstream inFile(inputFilePath);
+  std::ifstream inFile(inputFilePath, std::ios::binary | std::ios::ate);
   if(!inFile.is_open())
   {
     throw common::RuntimeError("Fajl na putanji " + inputFilePath + " nije mogao biti otvoren!");
   }
 
-  uint32_t nextAddress = UINT32_MAX;
-  emulator_core::CodeSegments segments;
-  std::string line;
-  while(std::getline(inFile, line))
+  std::string content(static_cast<size_t>(inFile.tellg()), '\0');
+  inFile.seekg(0);
+  if(!inFile.read(content.data(), content.size()))
   {
-    if (line.empty())
-    {
-      continue;
-    }
+    throw common::RuntimeError("Greska pri citanju fajla " + inputFilePath + "!");
+  }
 
-    uint32_t colonPos = line.find(':');
-    if(colonPos == std::string::npos)
+  // prvi prolaz odredjuje segmente i njihove velicine, drugi upisuje bajtove direktno u segmente
+  emulator_core::CodeSegments segments;
+  std::vector<uint32_t> segmentSizes;
+  uint32_t nextAddress = UINT32_MAX;
+  HexLineReader sizeReader(content);
+  while(sizeReader.nextLine())
+  {
+    if(sizeReader.getAddress() != nextAddress) // segment nije spojen, pravimo novi objekat
     {
-      throw common::RuntimeError("Nevazeci format linije " + line);
+      segments.emplace_back(sizeReader.getAddress());
+      segmentSizes.push_back(0);
+      nextAddress = sizeReader.getAddress();
     }
-    uint32_t address = std::stoul(line.substr(0, colonPos), nullptr, 16);
+    uint32_t numBytes = sizeReader.countBytes();
+    segmentSizes.back() += numBytes;
+    nextAddress += numBytes;
+  }
 
-    if(address != nextAddress) // segment nije spojen, pravimo novi objekat
-    {
-      segments.emplace_back(address);
-      nextAddress = address;
-    }
-    auto& segment = segments.back();
+  for(uint32_t i = 0, numSegments = segments.size(); i < numSegments; ++i)
+  {
+    segments[i].code.resize(segmentSizes[i]);
+  }
 
-    std::stringstream byteStream(line.substr(colonPos + 1));
-    std::string byteStr;
-    while(byteStream >> byteStr)
+  uint8_t* output = nullptr;
+  uint32_t segmentIndex = 0;
+  nextAddress = UINT32_MAX;
+  HexLineReader byteReader(content);
+  while(byteReader.nextLine())
+  {
+    if(byteReader.getAddress() != nextAddress) // iste granice segmenata kao u prvom prolazu
     {
-      uint8_t byte = static_cast<uint8_t>(std::stoi(byteStr, nullptr, 16));
-      //std::cout << "BYTE: " << std::hex << (int)byte << "\n";
-      segment.code.emplace_back(byte);
-      ++nextAddress;
+      output = segments[segmentIndex++].code.data();
+      nextAddress = byteReader.getAddress();
     }
+    uint32_t numBytes = byteReader.decodeBytes(output);
+    output += numBytes;
+    nextAddress += numBytes;
   }
 
   return segments;
 }
 
-} // namespace common
\ No newline at end of file
+} // namespace common
@@ -0,0 +1,131 @@
+#include <common/link_state_file_processor.hpp>
+#include <common/exceptions.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+const std::string STATE_MAGIC = "!lnkstate";
+
+// putanja je poslednje polje i moze sadrzati ':'
+std::vector<std::string> splitLine(const std::string& line, uint32_t maxTokens)
+{
+  std::vector<std::string> tokens;
+  size_t start = 0;
+  while(tokens.size() + 1 < maxTokens)
+  {
+    size_t separatorPos = line.find(':', start);
+    if(separatorPos == std::string::npos)
+    {
+      break;
+    }
+    tokens.push_back(line.substr(start, separatorPos - start));
+    start = separatorPos + 1;
+  }
+  tokens.push_back(line.substr(start));
+
+  return tokens;
+}
+
+} // namespace
+
+namespace common
+{
+
+void LinkStateFileProcessor::writeToFile(const LinkState& state, const std::string& filePath)
+{
+  std::ofstream outFile(filePath, std::ios::binary);
+  if(!outFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  outFile << STATE_MAGIC << "\n";
+  outFile << "Options:" << std::hex << state.optionsHash << std::dec << "\n";
+  for(const LinkStateSection& section : state.sections)
+  {
+    outFile << "Section:" << section.name << ":" << section.startAddress << ":" << section.size
+            << ":" << section.imageOffset << "\n";
+  }
+  for(const LinkStateSymbol& symbol : state.symbols)
+  {
+    outFile << "Symbol:" << symbol.name << ":" << symbol.value << "\n";
+  }
+  for(const LinkStateInput& input : state.inputs)
+  {
+    outFile << "Input:" << std::hex << input.contentHash << ":" << input.layoutHash << std::dec
+            << ":" << input.filePath << "\n";
+    for(const LinkStateInputSection& section : input.sections)
+    {
+      outFile << "InputSection:" << section.sectionNumber << ":" << section.globalSectionId
+              << ":" << section.offset << "\n";
+    }
+  }
+  outFile << "Image:" << state.image.size() << "\n";
+  outFile.write(reinterpret_cast<const char*>(state.image.data()), state.image.size());
+}
+//-----------------------------------------------------------------------------------------------------------
+bool LinkStateFileProcessor::readFromFile(const std::string& filePath, LinkState& state)
+{
+  std::ifstream inFile(filePath, std::ios::binary);
+  std::string line;
+  if(!inFile.is_open() || !std::getline(inFile, line) || line != STATE_MAGIC)
+  {
+    return false;
+  }
+
+  try
+  {
+    while(std::getline(inFile, line))
+    {
+      std::string recordType = line.substr(0, line.find(':'));
+      if(recordType == "Options")
+      {
+        state.optionsHash = std::stoull(splitLine(line, 2)[1], nullptr, 16);
+      }
+      else if(recordType == "Section")
+      {
+        std::vector<std::string> tokens = splitLine(line, 5);
+        state.sections.push_back({tokens.at(1), static_cast<uint32_t>(std::stoul(tokens.at(2))),
+                                  static_cast<uint32_t>(std::stoul(tokens.at(3))),
+                                  static_cast<uint32_t>(std::stoul(tokens.at(4)))});
+      }
+      else if(recordType == "Symbol")
+      {
+        std::vector<std::string> tokens = splitLine(line, 3);
+        state.symbols.push_back({tokens.at(1), static_cast<uint32_t>(std::stoul(tokens.at(2)))});
+      }
+      else if(recordType == "Input")
+      {
+        std::vector<std::string> tokens = splitLine(line, 4);
+        state.inputs.push_back({tokens.at(3), std::stoull(tokens.at(1), nullptr, 16),
+                                std::stoull(tokens.at(2), nullptr, 16), {}});
+      }
+      else if(recordType == "InputSection" && !state.inputs.empty())
+      {
+        std::vector<std::string> tokens = splitLine(line, 4);
+        state.inputs.back().sections.push_back({static_cast<uint32_t>(std::stoul(tokens.at(1))),
+                                                static_cast<uint32_t>(std::stoul(tokens.at(2))),
+                                                static_cast<uint32_t>(std::stoul(tokens.at(3)))});
+      }
+      else if(recordType == "Image")
+      {
+        state.image.resize(std::stoull(splitLine(line, 2).at(1)));
+        return static_cast<bool>(inFile.read(reinterpret_cast<char*>(state.image.data()), state.image.size()));
+      }
+      else
+      {
+        return false;
+      }
+    }
+  }
+  catch(const std::exception&)
+  {
+    return false;
+  }
+
+  return false; // nema izlazne slike
+}
+
+} // namespace common
@@ -0,0 +1,84 @@
+#include <common/map_file_processor.hpp>
+#include <common/exceptions.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+common::MapEntry parseMapEntry(const std::string& line, bool hasSize)
+{
+  std::istringstream lineStream(line);
+  std::string token;
+  std::vector<std::string> tokens;
+
+  while(std::getline(lineStream, token, ':'))
+  {
+    tokens.push_back(token);
+  }
+
+  if(tokens.size() != (hasSize ? 4 : 3))
+  {
+    throw common::RuntimeError("Nevazeci format linije mape memorije " + line);
+  }
+
+  uint32_t size = hasSize ? std::stoul(tokens[3]) : 0;
+  return {tokens[1], static_cast<uint32_t>(std::stoul(tokens[2], nullptr, 16)), size};
+}
+
+} // namespace
+
+namespace common
+{
+
+void MapFileProcessor::writeToFile(const MapFileData& data, const std::string& filePath)
+{
+  std::ofstream outFile(filePath);
+  if(!outFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  for(const MapEntry& section : data.sections)
+  {
+    outFile << "Section:" << section.name << ":" << std::hex << section.address
+            << ":" << std::dec << section.size << "\n";
+  }
+
+  for(const MapEntry& symbol : data.symbols)
+  {
+    outFile << "Symbol:" << symbol.name << ":" << std::hex << symbol.address << std::dec << "\n";
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+MapFileData MapFileProcessor::readFromFile(const std::string& filePath)
+{
+  std::ifstream inFile(filePath);
+  if(!inFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  MapFileData data;
+  std::string line;
+  while(std::getline(inFile, line))
+  {
+    if(line.rfind("Section:", 0) == 0)
+    {
+      data.sections.emplace_back(parseMapEntry(line, true));
+    }
+    else if(line.rfind("Symbol:", 0) == 0)
+    {
+      data.symbols.emplace_back(parseMapEntry(line, false));
+    }
+    else if(!line.empty())
+    {
+      throw RuntimeError("Nevazeci format linije mape memorije " + line);
+    }
+  }
+
+  return data;
+}
+
+} // namespace common
@@ -1,24 +1,248 @@
 #include <common/object_file_processor.hpp>
 #include <common/exceptions.hpp>
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cstdint>
+#include <cstring>
+#include <string_view>
+
+using namespace common;
 
 namespace
 {
 constexpr uint32_t INVALID_SECTION = 0;
+constexpr std::string_view SYMBOL_TABLE_HEADER = "Sym:";
+constexpr std::string_view RELOCATION_HEADER = "Rel:";
+constexpr std::string_view CODE_HEADER = "Code:";
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+constexpr size_t BYTES_PER_BLOCK = 4 * 1024;
+
+// "00" - "99", dve cifre odjednom
+constexpr char DIGIT_PAIRS[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+struct ByteText
+{
+  char text[4]; // decimalna vrednost bajta i razmak
+  uint8_t length;
+};
+
+// tekst svakog bajta koda ("0 " - "255 ") se racuna jednom
+const std::array<ByteText, 256> BYTE_TEXTS = []()
+{
+  std::array<ByteText, 256> byteTexts{};
+  for(uint32_t value = 0; value < 256; ++value)
+  {
+    std::string text = std::to_string(value) + " ";
+    std::memcpy(byteTexts[value].text, text.data(), text.size());
+    byteTexts[value].length = text.size();
+  }
+  return byteTexts;
+}();
 
-uint32_t findSection(const AssemblerOutputData& data, const std::string& symbolName)
+// prolaz kroz tekst objektnog fajla bez kopiranja: red po red, polja razdvojena sa ':'
+class ObjectTextReader
 {
-  for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+public:
+  explicit ObjectTextReader(std::string_view text)
+    : position(text.data()), end(text.data() + text.size()) {}
+
+  // isto kao std::getline: poslednji red ne mora imati '\n'
+  bool nextLine()
   {
-    if(data.symbolTable[i].name == symbolName)
+    if(position == end)
+    {
+      return false;
+    }
+
+    lineBegin = position;
+    lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+    if(lineEnd == nullptr)
     {
-      return i;
+      lineEnd = end;
     }
+    position = lineEnd == end ? end : lineEnd + 1;
+    fieldPosition = lineBegin;
+    return true;
   }
 
-  return INVALID_SECTION;
-}
+  std::string_view line() const { return std::string_view(lineBegin, lineEnd - lineBegin); }
+
+  // "Rel:broj" / "Code:broj". Red simbola sa istim imenom ima jos polja, pa se ne prepoznaje kao zaglavlje
+  bool readSectionHeader(std::string_view prefix, uint32_t& sectionNumber) const
+  {
+    std::string_view currentLine = line();
+    if(currentLine.size() <= prefix.size() || currentLine.compare(0, prefix.size(), prefix) != 0)
+    {
+      return false;
+    }
+
+    const char* numberEnd = lineEnd;
+    auto [parsedEnd, errorCode] = std::from_chars(lineBegin + prefix.size(), numberEnd, sectionNumber);
+    return errorCode == std::errc() && parsedEnd == numberEnd;
+  }
+
+  std::string_view nextField()
+  {
+    const char* fieldEnd = std::find(fieldPosition, lineEnd, ':');
+    std::string_view field(fieldPosition, fieldEnd - fieldPosition);
+    fieldPosition = fieldEnd == lineEnd ? lineEnd : fieldEnd + 1;
+    return field;
+  }
+
+  template<typename T>
+  T nextNumber()
+  {
+    std::string_view field = nextField();
+    T value{};
+    auto [parsedEnd, errorCode] = std::from_chars(field.data(), field.data() + field.size(), value);
+    if(errorCode != std::errc() || parsedEnd != field.data() + field.size())
+    {
+      throwFormatError();
+    }
+    return value;
+  }
+
+  // decimalni bajtovi razdvojeni razmacima
+  void readBytes(std::vector<uint8_t>& bytes) const
+  {
+    const char* current = lineBegin;
+    while(true)
+    {
+      while(current != lineEnd && *current == ' ')
+      {
+        ++current;
+      }
+      if(current == lineEnd)
+      {
+        return;
+      }
+
+      uint32_t value = 0;
+      auto [parsedEnd, errorCode] = std::from_chars(current, lineEnd, value);
+      if(errorCode != std::errc() || value > UINT8_MAX)
+      {
+        throwFormatError();
+      }
+      bytes.push_back(static_cast<uint8_t>(value));
+      current = parsedEnd;
+    }
+  }
+
+  [[noreturn]] void throwFormatError() const
+  {
+    throw RuntimeError("Neispravan red objektnog fajla: " + std::string(line()));
+  }
+private:
+  const char* position;
+  const char* end;
+  const char* lineBegin = nullptr;
+  const char* lineEnd = nullptr;
+  const char* fieldPosition = nullptr;
+};
+
+// formatira u bafer koji se povremeno prazni u fajl. Bafer je po niti i ponovo se koristi za sledeci fajl
+class ObjectFileWriter
+{
+public:
+  explicit ObjectFileWriter(const std::string& filePath)
+    : filePath(filePath), outFile(filePath, std::ios::binary)
+  {
+    if(!outFile.is_open())
+    {
+      throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+    }
+    buffer.clear();
+  }
+
+  void append(std::string_view text)
+  {
+    buffer.append(text.data(), text.size());
+  }
+
+  void append(char character)
+  {
+    buffer.push_back(character);
+  }
+
+  void appendUnsigned(uint32_t value)
+  {
+    char digits[10];
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+    while(value >= 100)
+    {
+      uint32_t pairIndex = (value % 100) * 2;
+      value /= 100;
+      *--begin = DIGIT_PAIRS[pairIndex + 1];
+      *--begin = DIGIT_PAIRS[pairIndex];
+    }
+    if(value >= 10)
+    {
+      *--begin = DIGIT_PAIRS[value * 2 + 1];
+      *--begin = DIGIT_PAIRS[value * 2];
+    }
+    else
+    {
+      *--begin = static_cast<char>('0' + value);
+    }
+    buffer.append(begin, end);
+  }
+
+  void appendInt(int value)
+  {
+    if(value < 0)
+    {
+      buffer.push_back('-');
+      appendUnsigned(0u - static_cast<uint32_t>(value));
+      return;
+    }
+    appendUnsigned(value);
+  }
+
+  // bajtovi kao decimalni brojevi razdvojeni razmakom, u blokovima da bafer ne raste sa velicinom sekcije
+  void appendBytes(const uint8_t* begin, const uint8_t* end)
+  {
+    while(begin != end)
+    {
+      const uint8_t* blockEnd = begin + std::min<size_t>(end - begin, BYTES_PER_BLOCK);
+      for(; begin != blockEnd; ++begin)
+      {
+        const ByteText& byteText = BYTE_TEXTS[*begin];
+        buffer.append(byteText.text, byteText.length);
+      }
+      flushIfFull();
+    }
+  }
+
+  void flushIfFull()
+  {
+    if(buffer.size() >= FLUSH_THRESHOLD)
+    {
+      flush();
+    }
+  }
+
+  void flush()
+  {
+    if(!outFile.write(buffer.data(), buffer.size()))
+    {
+      throw RuntimeError("Greska pri upisu u fajl " + filePath + "!");
+    }
+    buffer.clear();
+  }
+private:
+  static thread_local std::string buffer;
+
+  const std::string& filePath;
+  std::ofstream outFile;
+};
+
+thread_local std::string ObjectFileWriter::buffer;
 
 } // namespace unnamed
 
@@ -34,171 +258,193 @@ enum class ReadMode
 
 void ObjectFileProcessor::writeToFile(const AssemblerOutputData& data, const std::string& filePath)
 {
-	std::ofstream outFile(filePath);
-	if (!outFile.is_open()) 
-	{
-		throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
-	}
+	ObjectFileWriter writer(filePath);
 
 	// Tabela simbola
-	outFile << "Sym:\n";
+	writer.append(SYMBOL_TABLE_HEADER);
+	writer.append('\n');
 	for (const Symbol& symbol : data.symbolTable)
-	{      
-	outFile << symbol.name << ":" << symbol.sectionNumber << ":" << symbol.value << ":"
-			<< (symbol.isGlobal ? "1" : "0") << ":" << (symbol.isExtern ? "1" : "0") << ":"
-			<< (symbol.isDefined ? "1" : "0") << ":" << symbol.size << "\n";
+	{
+		writer.append(symbol.name);
+		writer.append(':');
+		writer.appendUnsigned(symbol.sectionNumber);
+		writer.append(':');
+		writer.appendInt(symbol.value);
+		writer.append(symbol.isGlobal ? ":1" : ":0");
+		writer.append(symbol.isExtern ? ":1" : ":0");
+		writer.append(symbol.isDefined ? ":1:" : ":0:");
+		writer.appendUnsigned(symbol.size);
+		writer.append('\n');
+		writer.flushIfFull();
+	}
+
+	// sekcije su u tabeli simbola redom kojim su otvorene (sectionOrder), prepoznaju se po indeksu
+	std::vector<uint32_t> sectionNumbers;
+	sectionNumbers.reserve(data.sectionOrder.size());
+	for (uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+	{
+		if (data.symbolTable[i].sectionNumber == i)
+		{
+			sectionNumbers.push_back(i);
+		}
 	}
-	
+
 	// Relokacioni zapisi
-	for (const std::string& sectionName : data.sectionOrder)
+	for (uint32_t sectionNumber : sectionNumbers)
 	{
-		uint32_t sectionNumber = findSection(data, sectionName);
-		if(data.sectionRelocationMap.find(sectionNumber) == data.sectionRelocationMap.end())
+		auto relocationIter = data.sectionRelocationMap.find(sectionNumber);
+		if (relocationIter == data.sectionRelocationMap.end())
 		{
 			continue;
 		}
-		const auto& relocationEntries = data.sectionRelocationMap.at(sectionNumber);
 
-		outFile << "Rel:" << sectionNumber << "\n";
-		for (const RelocationEntry& entry : relocationEntries)
+		writer.append(RELOCATION_HEADER);
+		writer.appendUnsigned(sectionNumber);
+		writer.append('\n');
+		for (const RelocationEntry& entry : relocationIter->second)
 		{
-			outFile << static_cast<int>(entry.operationCode)
-							<< ":" << entry.offset
-							<< ":" << entry.symbolTableReference << "\n";
+			writer.appendUnsigned(static_cast<uint32_t>(entry.operationCode));
+			writer.append(':');
+			writer.appendUnsigned(entry.offset);
+			writer.append(':');
+			writer.appendUnsigned(entry.symbolTableReference);
+			writer.append('\n');
+			writer.flushIfFull();
 		}
 	}
 
-	// Generisani kod
-	for (const auto& sectionName : data.sectionOrder)
+	// Generisani kod: kod pa bazen literala, bez pravljenja spojene kopije
+	for (uint32_t sectionNumber : sectionNumbers)
 	{
-		uint32_t sectionNumber = findSection(data, sectionName);
-		if(data.sectionMemoryMap.find(sectionNumber) == data.sectionMemoryMap.end())
+		auto memoryIter = data.sectionMemoryMap.find(sectionNumber);
+		if (memoryIter == data.sectionMemoryMap.end())
 		{
 			continue;
 		}
-		const auto& sectionMemory = data.sectionMemoryMap.at(sectionNumber);
+		const SectionMemory& sectionMemory = memoryIter->second;
+		const SectionMemory::MemorySegment& code = sectionMemory.getCode();
+		const SectionMemory::MemorySegment& literalPool = sectionMemory.getLiteralPool();
 
-		outFile << "Code:" << sectionNumber << "\n";
-		for (uint8_t byte : sectionMemory.getSectionMemory())
-		{
-			outFile << (int)byte << " ";
-		}
-		outFile << "\n";
+		writer.append(CODE_HEADER);
+		writer.appendUnsigned(sectionNumber);
+		writer.append('\n');
+		writer.appendBytes(code.data(), code.data() + code.size());
+		writer.appendBytes(literalPool.data(), literalPool.data() + literalPool.size());
+		writer.append('\n');
 	}
 
-	outFile.close();
-
+	writer.flush();
 }
 //-----------------------------------------------------------------------------------------------------------
 lnk_core::LinkerInputData ObjectFileProcessor::readFromFile(const std::string& filePath)
 {
-	lnk_core::LinkerInputData data;
-
-	std::ifstream inFile(filePath);
+	std::ifstream inFile(filePath, std::ios::binary | std::ios::ate);
 
 	if (!inFile.is_open())
 	{
 		throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
 	}
-	
-	std::string line;
-	ReadMode readMode;
-	uint32_t sectionNumber = INVALID_SECTION;
-	while (std::getline(inFile, line))
+
+	// ceo fajl jednim citanjem, parser radi direktno nad baferom
+	std::string content(static_cast<size_t>(inFile.tellg()), '\0');
+	inFile.seekg(0);
+	if (!inFile.read(content.data(), content.size()))
 	{
-		std::istringstream lineStream(line);
-		std::string token;
+		throw RuntimeError("Greska pri citanju fajla " + filePath + "!");
+	}
 
-		if (line.find("Sym:") != std::string::npos)
+	return readFromBuffer(content);
+}
+//-----------------------------------------------------------------------------------------------------------
+lnk_core::LinkerInputData ObjectFileProcessor::readFromBuffer(std::string_view text)
+{
+	lnk_core::LinkerInputData data;
+	ObjectTextReader reader(text);
+
+	ReadMode readMode = ReadMode::SYMBOL_TABLE;
+	std::vector<RelocationEntry>* relocations = nullptr;
+	uint32_t sectionNumber = INVALID_SECTION;
+	while (reader.nextLine())
+	{
+		if (reader.line() == SYMBOL_TABLE_HEADER)
 		{
 			readMode = ReadMode::SYMBOL_TABLE;
 			continue;
 		}
-		else if (line.find("Rel:") != std::string::npos)
+		else if (reader.readSectionHeader(RELOCATION_HEADER, sectionNumber))
 		{
+			if (sectionNumber == INVALID_SECTION)
+			{
+				throw LinkerError("Greska u parsiranj relokacione tabele!");
+			}
 			readMode = ReadMode::RELOCATION_TABLE;
-			sectionNumber = parseSectionNumber(line);
-			std::vector<RelocationEntry> relocations;
+			relocations = &data.sectionRelocationMap[sectionNumber];
 			continue;
 		}
-		else if (line.find("Code:") != std::string::npos)
+		else if (reader.readSectionHeader(CODE_HEADER, sectionNumber))
 		{
+			// red sa bajtovima uvek sledi zaglavlje, prazan je za praznu sekciju
 			readMode = ReadMode::GENERATED_CODE;
-			sectionNumber = parseSectionNumber(line);
+			std::vector<uint8_t>& sectionData = data.sectionMemoryMap[sectionNumber];
+			if (sectionNumber < data.symbolTable.size())
+			{
+				sectionData.reserve(data.symbolTable[sectionNumber].size);
+			}
+			if (reader.nextLine())
+			{
+				reader.readBytes(sectionData);
+			}
 			continue;
 		}
 
 		switch(readMode)
 		{
 			case ReadMode::SYMBOL_TABLE:
-				data.symbolTable.emplace_back(parseSymbol(line));
+			{
+				std::string_view name = reader.nextField();
+				uint32_t symbolSectionNumber = reader.nextNumber<uint32_t>();
+				int value = reader.nextNumber<int>();
+				bool isGlobal = reader.nextField() == "1";
+				bool isExtern = reader.nextField() == "1";
+				bool isDefined = reader.nextField() == "1";
+				data.symbolTable.emplace_back(std::string(name), symbolSectionNumber, value,
+																			isGlobal, isExtern, isDefined, reader.nextNumber<uint32_t>());
 				break;
+			}
 			case ReadMode::RELOCATION_TABLE:
-				if(sectionNumber == INVALID_SECTION)
-				{
-					throw LinkerError("Greska u parsiranj relokacione tabele!");
-				}
-
-				data.sectionRelocationMap[sectionNumber].emplace_back(parseRelocationEntry(line));
+			{
+				OperationCodes oc = static_cast<OperationCodes>(reader.nextNumber<uint32_t>());
+				uint32_t offset = reader.nextNumber<uint32_t>();
+				relocations->emplace_back(oc, offset, reader.nextNumber<uint32_t>());
 				break;
+			}
 			case ReadMode::GENERATED_CODE:
-				data.sectionMemoryMap[sectionNumber] = parseSectionData(line);
+				reader.throwFormatError(); // posle reda sa bajtovima mora doci zaglavlje
 		}
 	}
 
-	inFile.close();
 	return data;
 }
 //-----------------------------------------------------------------------------------------------------------
-common::Symbol ObjectFileProcessor::parseSymbol(const std::string& line) {
-	
-	std::istringstream lineStream(line);
-	std::string token;
-	std::vector<std::string> tokens;
-
-	while (std::getline(lineStream, token, ':'))
-	{
-		tokens.push_back(token);
-	}
-	
-	return Symbol(tokens[0], std::stoul(tokens[1]), std::stoi(tokens[2]), 
-								tokens[3] == "1", tokens[4] == "1", tokens[5] == "1", std::stoul(tokens[6]));
-}
-//-----------------------------------------------------------------------------------------------------------
-uint32_t ObjectFileProcessor::parseSectionNumber(const std::string& line)
-{ 
-	uint32_t separatorPos = line.find(':');
-	return std::stoul(line.substr(separatorPos + 1));
-}
-//-----------------------------------------------------------------------------------------------------------
-RelocationEntry ObjectFileProcessor::parseRelocationEntry(const std::string& line)
+lnk_core::LinkerInputData ObjectFileProcessor::toLinkerInputData(AssemblerOutputData&& data)
 {
-	std::istringstream lineStream(line);
-	std::string token;
-	std::vector<std::string> tokens;
-
-	while (std::getline(lineStream, token, ':'))
+	lnk_core::LinkerInputData inputData;
+	inputData.symbolTable = std::move(data.symbolTable);
+	for (Symbol& symbol : inputData.symbolTable)
 	{
-			tokens.push_back(token);
+		symbol.symbolUsages.clear(); // cvorovi su u areni asemblera, linker ih ne koristi
 	}
 
-	OperationCodes oc = static_cast<OperationCodes>(std::stoi(tokens[0]));
-	return RelocationEntry(oc, std::stoul(tokens[1]), std::stoul(tokens[2]));
-}
-//-----------------------------------------------------------------------------------------------------------
-std::vector<uint8_t> ObjectFileProcessor::parseSectionData(const std::string& line)
-{
-	std::istringstream lineStream(line);
-	std::string token;
-
-	std::vector<uint8_t> sectionData;
-
-	while (lineStream >> token)
+	for (const auto& [sectionNumber, sectionMemory] : data.sectionMemoryMap)
 	{
-			sectionData.push_back(static_cast<uint8_t>(std::stoul(token)));
+		std::vector<uint8_t>& bytes = inputData.sectionMemoryMap[sectionNumber];
+		bytes.reserve(sectionMemory.getSectionSize());
+		bytes.insert(bytes.end(), sectionMemory.getCode().begin(), sectionMemory.getCode().end());
+		bytes.insert(bytes.end(), sectionMemory.getLiteralPool().begin(), sectionMemory.getLiteralPool().end());
 	}
+	inputData.sectionRelocationMap = std::move(data.sectionRelocationMap);
 
-	return sectionData;
+	return inputData;
 }
 
-} // common
\ No newline at end of file
+} // common
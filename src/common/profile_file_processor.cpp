@@ -0,0 +1,57 @@
+#include <common/profile_file_processor.hpp>
+#include <common/exceptions.hpp>
+
+#include <fstream>
+
+namespace
+{
+const std::string SECTION_PREFIX = "Section:";
+} // namespace
+
+namespace common
+{
+
+void ProfileFileProcessor::writeToFile(const std::vector<ProfileEntry>& entries, const std::string& filePath)
+{
+  std::ofstream outFile(filePath);
+  if(!outFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  for(const ProfileEntry& entry : entries)
+  {
+    outFile << SECTION_PREFIX << entry.name << ":" << entry.count << "\n";
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+std::vector<ProfileEntry> ProfileFileProcessor::readFromFile(const std::string& filePath)
+{
+  std::ifstream inFile(filePath);
+  if(!inFile.is_open())
+  {
+    throw RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  std::vector<ProfileEntry> entries;
+  std::string line;
+  while(std::getline(inFile, line))
+  {
+    if(line.empty())
+    {
+      continue;
+    }
+
+    size_t countPos = line.rfind(':');
+    if(line.rfind(SECTION_PREFIX, 0) != 0 || countPos < SECTION_PREFIX.size())
+    {
+      throw RuntimeError("Nevazeci format linije profila " + line);
+    }
+    entries.push_back({line.substr(SECTION_PREFIX.size(), countPos - SECTION_PREFIX.size()),
+                       std::stoull(line.substr(countPos + 1))});
+  }
+
+  return entries;
+}
+
+} // namespace common
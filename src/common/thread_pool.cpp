@@ -0,0 +1,111 @@
+#include <common/thread_pool.hpp>
+
+namespace common
+{
+
+ThreadPool::ThreadPool(uint32_t numThreads)
+{
+  // hardware_concurrency moze vratiti 0
+  for(uint32_t i = 1; i < numThreads; ++i)
+  {
+    workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isStopping = true;
+  }
+  wakeCondition.notify_all();
+
+  for(std::thread& worker : workers)
+  {
+    worker.join();
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void ThreadPool::parallelFor(uint32_t numTasks, const std::function<void(uint32_t)>& task)
+{
+  if(workers.empty() || numTasks <= 1)
+  {
+    for(uint32_t i = 0; i < numTasks; ++i)
+    {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    currentTask = &task;
+    this->numTasks = numTasks;
+    nextTask = 0;
+    numActiveWorkers = workers.size();
+    firstException = nullptr;
+    ++generation;
+  }
+  wakeCondition.notify_all();
+
+  runTasks();
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return numActiveWorkers == 0; });
+    currentTask = nullptr;
+    exception = firstException;
+  }
+
+  if(exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void ThreadPool::workerLoop()
+{
+  uint64_t seenGeneration = 0;
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wakeCondition.wait(lock, [this, seenGeneration] { return isStopping || generation != seenGeneration; });
+      if(isStopping)
+      {
+        return;
+      }
+      seenGeneration = generation;
+    }
+
+    runTasks();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if(--numActiveWorkers == 0)
+    {
+      doneCondition.notify_one();
+    }
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void ThreadPool::runTasks()
+{
+  for(uint32_t i = nextTask++; i < numTasks; i = nextTask++)
+  {
+    try
+    {
+      (*currentTask)(i);
+    }
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(!firstException)
+      {
+        firstException = std::current_exception();
+      }
+    }
+  }
+}
+
+} // namespace common
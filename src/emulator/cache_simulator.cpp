@@ -0,0 +1,286 @@
+#include <emulator/cache_simulator.hpp>
+#include <common/exceptions.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+
+bool isPowerOfTwo(uint32_t value)
+{
+  return value != 0 && (value & (value - 1)) == 0;
+}
+
+double toPercentage(uint64_t part, uint64_t total)
+{
+  return total == 0 ? 0.0 : 100.0 * part / total;
+}
+
+} // namespace
+
+namespace emulator_core
+{
+
+CacheConfig CacheConfig::parse(const std::string& name, const std::string& description)
+{
+  std::istringstream descriptionStream(description);
+  std::string token;
+  std::vector<std::string> tokens;
+
+  while(std::getline(descriptionStream, token, ':'))
+  {
+    tokens.push_back(token);
+  }
+
+  if(tokens.size() != 4)
+  {
+    throw common::EmulatorError("Nevazeci opis kesa " + description + ", ocekivano velicina:asocijativnost:linija:politika");
+  }
+
+  CacheConfig config;
+  config.name = name;
+  config.size = std::stoul(tokens[0], nullptr, 0);
+  config.associativity = std::stoul(tokens[1], nullptr, 0);
+  config.lineSize = std::stoul(tokens[2], nullptr, 0);
+
+  if(tokens[3] == "lru")
+  {
+    config.policy = ReplacementPolicy::LRU;
+  }
+  else if(tokens[3] == "fifo")
+  {
+    config.policy = ReplacementPolicy::FIFO;
+  }
+  else if(tokens[3] == "random")
+  {
+    config.policy = ReplacementPolicy::RANDOM;
+  }
+  else
+  {
+    throw common::EmulatorError("Nepoznata politika zamene " + tokens[3]);
+  }
+
+  if(!isPowerOfTwo(config.lineSize) || config.associativity == 0 ||
+     config.size % (config.associativity * config.lineSize) != 0 ||
+     !isPowerOfTwo(config.size / (config.associativity * config.lineSize)))
+  {
+    throw common::EmulatorError("Nevazeca geometrija kesa " + description);
+  }
+
+  return config;
+}
+//-----------------------------------------------------------------------------------------------------------
+CacheLevel::CacheLevel(const CacheConfig& config)
+  : config(config),
+    numSets(config.size / (config.associativity * config.lineSize)),
+    lineShift(0),
+    lines(config.size / config.lineSize)
+{
+  while((1U << lineShift) < config.lineSize)
+  {
+    ++lineShift;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+bool CacheLevel::access(uint32_t address)
+{
+  ++clock;
+  uint32_t lineAddress = address >> lineShift;
+  uint32_t setIndex = lineAddress & (numSets - 1);
+  uint32_t tag = lineAddress / numSets;
+  uint32_t firstWay = setIndex * config.associativity;
+
+  for(uint32_t way = firstWay, lastWay = firstWay + config.associativity; way < lastWay; ++way)
+  {
+    Line& line = lines[way];
+    if(line.isValid && line.tag == tag)
+    {
+      if(config.policy == ReplacementPolicy::LRU)
+      {
+        line.stamp = clock;
+      }
+      ++hits;
+      return true;
+    }
+  }
+
+  Line& victim = lines[chooseVictim(firstWay)];
+  victim.tag = tag;
+  victim.stamp = clock;
+  victim.isValid = true;
+  ++misses;
+  return false;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t CacheLevel::chooseVictim(uint32_t firstWay)
+{
+  uint32_t lastWay = firstWay + config.associativity;
+  for(uint32_t way = firstWay; way < lastWay; ++way)
+  {
+    if(!lines[way].isValid)
+    {
+      return way;
+    }
+  }
+
+  if(config.policy == ReplacementPolicy::RANDOM)
+  {
+    // xorshift32, deterministicki izmedju pokretanja
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return firstWay + randomState % config.associativity;
+  }
+
+  // LRU i FIFO izbacuju liniju sa najmanjim vremenskim zigom
+  uint32_t victim = firstWay;
+  for(uint32_t way = firstWay + 1; way < lastWay; ++way)
+  {
+    if(lines[way].stamp < lines[victim].stamp)
+    {
+      victim = way;
+    }
+  }
+
+  return victim;
+}
+//-----------------------------------------------------------------------------------------------------------
+CacheSimulator::CacheSimulator(const CacheOptions& options)
+{
+  levels.reserve(options.instructionCaches.size() + options.dataCaches.size() + options.unifiedCaches.size());
+
+  for(const CacheConfig& config : options.instructionCaches)
+  {
+    instructionPath.push_back(levels.size());
+    levels.emplace_back(config);
+  }
+  for(const CacheConfig& config : options.dataCaches)
+  {
+    dataPath.push_back(levels.size());
+    levels.emplace_back(config);
+  }
+  for(const CacheConfig& config : options.unifiedCaches)
+  {
+    instructionPath.push_back(levels.size());
+    dataPath.push_back(levels.size());
+    levels.emplace_back(config);
+  }
+
+  if(!options.mapFilePath.empty())
+  {
+    memoryMap.load(options.mapFilePath);
+  }
+  sectionStatistics.resize(memoryMap.getSections().size());
+  symbolStatistics.resize(memoryMap.getSymbols().size());
+}
+//-----------------------------------------------------------------------------------------------------------
+void CacheSimulator::access(const std::vector<uint32_t>& path, uint32_t address, bool isFetch)
+{
+  // nivo se pita samo ako su svi blizi nivoi promasili
+  bool isFirstLevelHit = true;
+  for(uint32_t i = 0, numLevels = path.size(); i < numLevels; ++i)
+  {
+    bool isHit = levels[path[i]].access(address);
+    if(i == 0)
+    {
+      isFirstLevelHit = isHit;
+    }
+    if(isHit)
+    {
+      break;
+    }
+  }
+
+  uint32_t sectionIndex = memoryMap.findSection(address);
+  if(sectionIndex == MemoryMap::NOT_FOUND)
+  {
+    record(unmappedStatistics, isFetch, isFirstLevelHit);
+    return;
+  }
+  record(sectionStatistics[sectionIndex], isFetch, isFirstLevelHit);
+
+  uint32_t symbolIndex = memoryMap.findSymbol(address);
+  if(symbolIndex != MemoryMap::NOT_FOUND)
+  {
+    record(symbolStatistics[symbolIndex], isFetch, isFirstLevelHit);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void CacheSimulator::record(RegionStatistics& statistics, bool isFetch, bool isHit)
+{
+  if(isFetch)
+  {
+    ++statistics.fetches;
+    statistics.fetchMisses += isHit ? 0 : 1;
+  }
+  else
+  {
+    ++statistics.dataAccesses;
+    statistics.dataMisses += isHit ? 0 : 1;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void CacheSimulator::printReport() const
+{
+  std::cout << std::dec << std::setfill(' ') << std::fixed << std::setprecision(2);
+  std::cout << "===================================\n";
+  std::cout << "SIMULACIJA KESA:\n";
+  std::cout << std::left << std::setw(8) << "Nivo" << std::right
+            << std::setw(10) << "Velicina" << std::setw(6) << "Asoc" << std::setw(7) << "Linija"
+            << std::setw(14) << "Pogodaka" << std::setw(14) << "Promasaja" << std::setw(10) << "Pogodak%" << "\n";
+  for(const CacheLevel& level : levels)
+  {
+    const CacheConfig& config = level.getConfig();
+    uint64_t accesses = level.getHits() + level.getMisses();
+    std::cout << std::left << std::setw(8) << config.name << std::right
+              << std::setw(10) << config.size << std::setw(6) << config.associativity << std::setw(7) << config.lineSize
+              << std::setw(14) << level.getHits() << std::setw(14) << level.getMisses()
+              << std::setw(9) << toPercentage(level.getHits(), accesses) << "%\n";
+  }
+
+  printRegions(memoryMap.getSections(), sectionStatistics, "Po sekcijama (promasaji prvog nivoa):");
+  printRegions(memoryMap.getSymbols(), symbolStatistics, "Po simbolima (promasaji prvog nivoa):");
+
+  if(unmappedStatistics.fetches + unmappedStatistics.dataAccesses != 0)
+  {
+    std::cout << "Van poznatih sekcija: dohvatanja " << unmappedStatistics.fetches
+              << " (promasaji " << unmappedStatistics.fetchMisses << "), podaci " << unmappedStatistics.dataAccesses
+              << " (promasaji " << unmappedStatistics.dataMisses << ")\n";
+  }
+  std::cout << "===================================\n";
+}
+//-----------------------------------------------------------------------------------------------------------
+void CacheSimulator::printRegions(
+  const std::vector<MemoryRegion>& regions,
+  const std::vector<RegionStatistics>& statistics,
+  const std::string& title)
+{
+  if(regions.empty())
+  {
+    return;
+  }
+
+  std::cout << "-----------------------------------\n";
+  std::cout << title << "\n";
+  std::cout << std::left << std::setw(24) << "Ime" << std::right
+            << std::setw(12) << "Dohvatanja" << std::setw(10) << "I-prom%"
+            << std::setw(12) << "Podaci" << std::setw(10) << "D-prom%" << "\n";
+  for(uint32_t i = 0, numRegions = regions.size(); i < numRegions; ++i)
+  {
+    const RegionStatistics& regionStatistics = statistics[i];
+    if(regionStatistics.fetches + regionStatistics.dataAccesses == 0)
+    {
+      continue;
+    }
+
+    std::cout << std::left << std::setw(24) << regions[i].name << std::right
+              << std::setw(12) << regionStatistics.fetches
+              << std::setw(9) << toPercentage(regionStatistics.fetchMisses, regionStatistics.fetches) << "%"
+              << std::setw(12) << regionStatistics.dataAccesses
+              << std::setw(9) << toPercentage(regionStatistics.dataMisses, regionStatistics.dataAccesses) << "%\n";
+  }
+}
+
+} // namespace emulator_core
@@ -0,0 +1,119 @@
+#include <emulator/cycle_model.hpp>
+#include <emulator/performance_counters.hpp>
+#include <common/exceptions.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+
+using common::OperationCodes;
+
+constexpr uint32_t DEFAULT_LATENCY = 1;
+constexpr uint32_t DEFAULT_MEMORY_ACCESS_PENALTY = 3;
+constexpr uint32_t DEFAULT_BRANCH_TAKEN_PENALTY = 2;
+constexpr uint32_t DEFAULT_INTERRUPT_ENTRY_COST = 12;
+
+} // namespace
+
+namespace emulator_core
+{
+
+CycleModel::CycleModel()
+  : memoryAccessPenalty(DEFAULT_MEMORY_ACCESS_PENALTY),
+    branchTakenPenalty(DEFAULT_BRANCH_TAKEN_PENALTY),
+    interruptEntryCost(DEFAULT_INTERRUPT_ENTRY_COST)
+{
+  latencies.fill(DEFAULT_LATENCY);
+
+  // pristupi memoriji se dodatno placaju kroz memoryAccessPenalty
+  latencies[static_cast<uint8_t>(OperationCodes::MUL)] = 4;
+  latencies[static_cast<uint8_t>(OperationCodes::DIV)] = 24;
+  latencies[static_cast<uint8_t>(OperationCodes::CALL_REG_DIR)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::CALL_REG_IND)] = 3;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_REG_MEM_DIR)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_REG_MEM_DIR_INC)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_CSR_MEM_DIR)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_CSR_MEM_DIR_INC)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::ST_MEM_IND)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_REG_CSR)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_CSR_REG)] = 2;
+  latencies[static_cast<uint8_t>(OperationCodes::LD_CSR_OR)] = 2;
+}
+//-----------------------------------------------------------------------------------------------------------
+void CycleModel::load(const std::string& filePath)
+{
+  std::ifstream inFile(filePath);
+  if(!inFile.is_open())
+  {
+    throw common::RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  std::string line;
+  while(std::getline(inFile, line))
+  {
+    line = line.substr(0, line.find('#'));
+    std::istringstream lineStream(line);
+    std::string key;
+    uint32_t value;
+    if(!(lineStream >> key))
+    {
+      continue;
+    }
+    if(!(lineStream >> value))
+    {
+      throw common::EmulatorError("Nevazeca linija modela ciklusa: " + line);
+    }
+
+    if(key == "memory")
+    {
+      memoryAccessPenalty = value;
+      continue;
+    }
+    if(key == "branch")
+    {
+      branchTakenPenalty = value;
+      continue;
+    }
+    if(key == "interrupt")
+    {
+      interruptEntryCost = value;
+      continue;
+    }
+
+    bool isFound = false;
+    for(uint32_t i = 0, numCodes = latencies.size(); i < numCodes; ++i)
+    {
+      if(key == toString(static_cast<OperationCodes>(i)))
+      {
+        latencies[i] = value;
+        isFound = true;
+        break;
+      }
+    }
+    if(!isFound)
+    {
+      throw common::EmulatorError("Nepoznat kljuc modela ciklusa: " + key);
+    }
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void CycleModel::printReport(uint64_t instructionsRetired, uint64_t clockFrequency) const
+{
+  std::cout << std::dec << std::setfill(' ') << std::fixed << std::setprecision(2);
+  std::cout << "===================================\n";
+  std::cout << "MODEL CIKLUSA:\n";
+  std::cout << "Procenjeni ciklusi: " << cycles << "\n";
+  if(instructionsRetired != 0)
+  {
+    std::cout << "CPI: " << static_cast<double>(cycles) / instructionsRetired << "\n";
+  }
+  std::cout << "Procenjeno vreme na " << clockFrequency / 1000000.0 << " MHz: "
+            << cycles * 1000000.0 / clockFrequency << " us\n";
+  std::cout << "===================================\n";
+}
+
+} // namespace emulator_core
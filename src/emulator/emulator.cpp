@@ -3,31 +3,132 @@
 #include <common/executable_file_processor.hpp>
 
 #include <iostream>
+#include <iomanip>
 
 namespace
 {
 constexpr uint64_t DEFAULT_MEMORY_SIZE = (1ULL << 32);
+
+// maske u statusnom registru
+constexpr uint32_t STATUS_TIMER_MASK = 0x1; // Tr
+constexpr uint32_t STATUS_TERMINAL_MASK = 0x2; // Tl
+constexpr uint32_t STATUS_INTERRUPT_MASK = 0x4; // I
+
+uint32_t toPendingBit(emulator_core::InterruptType interruptType)
+{
+  return 1U << static_cast<uint8_t>(interruptType);
+}
+
+constexpr uint32_t NUM_REPORTED_PAIRS = 20;
+constexpr const char* FUSED_PATTERN_NAMES[] = {"IRET", "LOAD_MEMORY", "LOAD_PUSH", "PUSH_PAIR", "POP_PAIR"};
 } // unnamed
 
 namespace emulator_core
 {
 
-Emulator::Emulator(const std::string& inputFilePath)
-  : inputFilePath(inputFilePath), memory(DEFAULT_MEMORY_SIZE) {}
+Emulator::Emulator(const std::string& inputFilePath, const EmulatorOptions& options)
+  : memory(DEFAULT_MEMORY_SIZE), timer(options.timerClock, options.clockFrequency), options(options),
+    inputFilePath(inputFilePath)
+{
+  if(!options.cycleModelFilePath.empty())
+  {
+    cycleModel.load(options.cycleModelFilePath);
+  }
+
+  if(options.profilePairs)
+  {
+    pairProfile = std::make_unique<InstructionPairProfile>();
+  }
+
+  if(!options.profileFilePath.empty())
+  {
+    if(options.cacheOptions.mapFilePath.empty())
+    {
+      throw EmulatorError("Za -profile je potrebna mapa memorije (-map)!");
+    }
+    sectionProfile = std::make_unique<SectionProfile>(options.cacheOptions.mapFilePath);
+  }
+
+  if(options.cacheOptions.isEnabled())
+  {
+#ifdef EMULATOR_CACHE_SIMULATION
+    cacheSimulator = std::make_unique<CacheSimulator>(options.cacheOptions);
+    memory.attachCacheSimulator(cacheSimulator.get());
+#else
+    throw EmulatorError("Emulator nije preveden sa podrskom za simulaciju kesa (make CACHE_SIM=1)!");
+#endif
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+Emulator::Emulator(CodeSegments codeSegments, const EmulatorOptions& options)
+  : Emulator(std::string(), options)
+{
+  this->codeSegments = std::move(codeSegments);
+}
 //-----------------------------------------------------------------------------------------------------------
 void Emulator::emulate()
 {
-  const auto& segments = ExecutableFileProcessor::readFromFile(inputFilePath);
-  memory.init(segments);
+  if(!inputFilePath.empty())
+  {
+    codeSegments = ExecutableFileProcessor::readFromFile(inputFilePath);
+  }
+  memory.init(codeSegments);
   context.reset();
+  counters.start();
+  timer.start(cycleModel.getCycles());
   while(isRunning)
   {
-    uint32_t instruction = memory.readWord(context.readAndIncPC());
-    executeInstruction(toInstruction(instruction));
+    uint32_t pc = context.readAndIncPC();
+    if(sectionProfile != nullptr)
+    {
+      sectionProfile->record(pc);
+    }
+    uint32_t word = memory.fetchWord(pc);
+    AssemblerInstruction instruction = toInstruction(word);
+    if(!options.fuseInstructions || !executeFused(instruction, pc))
+    {
+      executeInstruction(instruction);
+      retire(instruction.oc, context.readGpr(PC) != pc + WORD_SIZE);
+    }
+
+    // prekidi se proveravaju samo na kraju bazicnog bloka (skok ili upis u status)
+    if(isBlockEnd)
+    {
+      isBlockEnd = false;
+      if(timer.update(cycleModel.getCycles()))
+      {
+        raiseInterrupt(InterruptType::TIMER);
+      }
+      if(pendingInterrupts.load(std::memory_order_relaxed) != 0 && isRunning)
+      {
+        handlePendingInterrupts();
+      }
+    }
   }
+  counters.stop();
 
   std::cout << "Izvrsavanje zaustavljeno HALT instrukcijom!\n";
   context.printState();
+  if(options.printStatistics)
+  {
+    counters.printReport();
+    cycleModel.printReport(counters.getInstructionsRetired(), options.clockFrequency);
+    printFusionReport();
+  }
+  if(pairProfile != nullptr)
+  {
+    pairProfile->printReport(NUM_REPORTED_PAIRS);
+  }
+  if(sectionProfile != nullptr)
+  {
+    sectionProfile->writeToFile(options.profileFilePath);
+  }
+#ifdef EMULATOR_CACHE_SIMULATION
+  if(cacheSimulator != nullptr)
+  {
+    cacheSimulator->printReport();
+  }
+#endif
 }
 //-----------------------------------------------------------------------------------------------------------
 AssemblerInstruction Emulator::toInstruction(uint32_t word)
@@ -67,7 +168,7 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       push(context.readGpr(PC));
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
-      context.writeGpr(PC, memory.readWord(regA + regB + instruction.disp));
+      context.writeGpr(PC, readMemory(regA + regB + instruction.disp));
       break;
     }
     case OperationCodes::JMP_IMM:
@@ -79,7 +180,7 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
     case OperationCodes::JMP_MEM_DIR:
     {
       uint32_t regA = context.readGpr(instruction.regA);
-      context.writeGpr(PC, memory.readWord(regA + instruction.disp));
+      context.writeGpr(PC, readMemory(regA + instruction.disp));
       break;
     }
     case OperationCodes::BEQ_IMM:
@@ -87,7 +188,9 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(regB == regC)
+      bool isTaken = regB == regC;
+      counters.branch(isTaken);
+      if(isTaken)
       {
         context.writeGpr(PC, regA + instruction.disp);
       }
@@ -98,9 +201,11 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(regB == regC)
+      bool isTaken = regB == regC;
+      counters.branch(isTaken);
+      if(isTaken)
       {
-        context.writeGpr(PC, memory.readWord(regA + instruction.disp));
+        context.writeGpr(PC, readMemory(regA + instruction.disp));
       }
       break;
     }
@@ -109,7 +214,9 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(regB != regC)
+      bool isTaken = regB != regC;
+      counters.branch(isTaken);
+      if(isTaken)
       {
         context.writeGpr(PC, regA + instruction.disp);
       }
@@ -120,9 +227,11 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(regB != regC)
+      bool isTaken = regB != regC;
+      counters.branch(isTaken);
+      if(isTaken)
       {
-        context.writeGpr(PC, memory.readWord(regA + instruction.disp));
+        context.writeGpr(PC, readMemory(regA + instruction.disp));
       }
       break;
     }
@@ -131,7 +240,9 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(static_cast<int>(regB) > static_cast<int>(regC))
+      bool isTaken = static_cast<int>(regB) > static_cast<int>(regC);
+      counters.branch(isTaken);
+      if(isTaken)
       {
         context.writeGpr(PC, regA + instruction.disp);
       }
@@ -142,9 +253,11 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      if(static_cast<int>(regB) > static_cast<int>(regC))
+      bool isTaken = static_cast<int>(regB) > static_cast<int>(regC);
+      counters.branch(isTaken);
+      if(isTaken)
       {
-        context.writeGpr(PC, memory.readWord(regA + instruction.disp));
+        context.writeGpr(PC, readMemory(regA + instruction.disp));
       }
       break;
     }
@@ -234,14 +347,15 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      memory.writeWord(regA + regB + instruction.disp, regC);
+      writeMemory(regA + regB + instruction.disp, regC);
+      break;
     }
     case OperationCodes::ST_MEM_IND:
     {
       uint32_t regA = context.readGpr(instruction.regA);
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      memory.writeWordIndirect(regA + regB + instruction.disp, regC);
+      writeMemoryIndirect(regA + regB + instruction.disp, regC);
       break;
     }
     case OperationCodes::ST_MEM_DIR_INC:
@@ -250,7 +364,7 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
       uint32_t regC = context.readGpr(instruction.regC);
       context.writeGpr(instruction.regA, regA + static_cast<char>(instruction.disp));
       regA = context.readGpr(instruction.regA);
-      memory.writeWord(regA, regC);
+      writeMemory(regA, regC);
       break;
     }
     case OperationCodes::LD_REG_IMM:
@@ -261,7 +375,7 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
     }
     case OperationCodes::LD_REG_CSR:
     {
-      uint32_t csrB = context.readControl(instruction.regB);
+      uint32_t csrB = readControl(instruction.regB);
       context.writeGpr(instruction.regA, csrB);
       break;
     }
@@ -269,40 +383,40 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
     {
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      uint32_t value = memory.readWord(regB + regC + instruction.disp);
+      uint32_t value = readMemory(regB + regC + instruction.disp);
       context.writeGpr(instruction.regA, value);
       break;
     }
     case OperationCodes::LD_REG_MEM_DIR_INC:
     {
       uint32_t regB = context.readGpr(instruction.regB);
-      context.writeGpr(instruction.regA, memory.readWord(regB));
+      context.writeGpr(instruction.regA, readMemory(regB));
       context.writeGpr(instruction.regB, regB + static_cast<char>(instruction.disp));
       break;
     }
     case OperationCodes::LD_CSR_REG:
     {
       uint32_t regB = context.readGpr(instruction.regB);
-      context.writeControl(instruction.regA, regB);
+      writeControl(instruction.regA, regB);
       break;
     }
     case OperationCodes::LD_CSR_OR:
     {
-      uint32_t csrB = context.readControl(instruction.regB);
-      context.writeControl(instruction.regA, csrB | instruction.disp);
+      uint32_t csrB = readControl(instruction.regB);
+      writeControl(instruction.regA, csrB | instruction.disp);
       break;
     }
     case OperationCodes::LD_CSR_MEM_DIR:
     {
       uint32_t regB = context.readGpr(instruction.regB);
       uint32_t regC = context.readGpr(instruction.regC);
-      context.writeControl(instruction.regA, memory.readWord(regB + regC + instruction.disp));
+      writeControl(instruction.regA, readMemory(regB + regC + instruction.disp));
       break;
     }
     case OperationCodes::LD_CSR_MEM_DIR_INC:
     {
       uint32_t regB = context.readGpr(instruction.regB);
-      context.writeControl(instruction.regA, memory.readWord(regB));
+      writeControl(instruction.regA, readMemory(regB));
       context.writeGpr(instruction.regB, regB + static_cast<char>(instruction.disp));
       break;
     }
@@ -313,26 +427,288 @@ void Emulator::executeInstruction(const AssemblerInstruction& instruction)
   }
 }
 //-----------------------------------------------------------------------------------------------------------
+// Izvrsava par instrukcija kao jednu spojenu instrukciju ako prva i naredna instrukcija cine poznat par.
+// Prva instrukcija para nikad ne menja PC, pa je druga uvek na pc + 4.
+bool Emulator::executeFused(const AssemblerInstruction& first, uint32_t pc)
+{
+  switch(first.oc)
+  {
+    case OperationCodes::LD_CSR_MEM_DIR_INC:
+    case OperationCodes::LD_REG_MEM_DIR:
+    case OperationCodes::ST_MEM_DIR_INC:
+    case OperationCodes::LD_REG_MEM_DIR_INC:
+      break;
+    default:
+      return false;
+  }
+
+  uint32_t nextPc = pc + WORD_SIZE;
+  AssemblerInstruction second = toInstruction(memory.peekWord(nextPc));
+  FusedPattern pattern = matchFused(first, second);
+  if(pattern == FusedPattern::NONE)
+  {
+    return false;
+  }
+
+  switch(pattern)
+  {
+    case FusedPattern::IRET:
+    {
+      uint32_t regB = context.readGpr(first.regB);
+      uint32_t status = readMemory(regB);
+      regB += static_cast<char>(first.disp);
+      uint32_t returnAddress = readMemory(regB);
+      writeControl(first.regA, status);
+      context.writeGpr(first.regB, regB + static_cast<char>(second.disp));
+      context.writeGpr(PC, returnAddress);
+      break;
+    }
+    case FusedPattern::LOAD_MEMORY:
+    {
+      uint32_t address = readMemory(nextPc + first.disp);
+      context.writeGpr(first.regA, readMemory(address));
+      context.writeGpr(PC, nextPc + WORD_SIZE);
+      break;
+    }
+    case FusedPattern::LOAD_PUSH:
+    {
+      uint32_t value = readMemory(nextPc + first.disp);
+      context.writeGpr(first.regA, value);
+      uint32_t regA = context.readGpr(second.regA) + static_cast<char>(second.disp);
+      context.writeGpr(second.regA, regA);
+      writeMemory(regA, value);
+      context.writeGpr(PC, nextPc + WORD_SIZE);
+      break;
+    }
+    case FusedPattern::PUSH_PAIR:
+    {
+      uint32_t firstAddress = context.readGpr(first.regA) + static_cast<char>(first.disp);
+      if(firstAddress + WORD_SIZE > nextPc && firstAddress < nextPc + WORD_SIZE) // prva instrukcija bi prepisala drugu
+      {
+        return false;
+      }
+      uint32_t secondAddress = firstAddress + static_cast<char>(second.disp);
+      writeMemory(firstAddress, context.readGpr(first.regC));
+      writeMemory(secondAddress, context.readGpr(second.regC));
+      context.writeGpr(first.regA, secondAddress);
+      context.writeGpr(PC, nextPc + WORD_SIZE);
+      break;
+    }
+    case FusedPattern::POP_PAIR:
+    {
+      uint32_t regB = context.readGpr(first.regB);
+      uint32_t firstValue = readMemory(regB);
+      regB += static_cast<char>(first.disp);
+      uint32_t secondValue = readMemory(regB);
+      context.writeGpr(first.regA, firstValue);
+      context.writeGpr(first.regB, regB + static_cast<char>(second.disp));
+      context.writeGpr(PC, nextPc + WORD_SIZE);
+      context.writeGpr(second.regA, secondValue); // moze biti PC (pop; ret)
+      break;
+    }
+    default:
+      return false;
+  }
+
+  memory.fetchWord(nextPc); // druga instrukcija je dohvacena (simulacija kesa)
+  ++fusedCounts[static_cast<uint8_t>(pattern)];
+  retire(first.oc, false);
+  retire(second.oc, context.readGpr(PC) != nextPc + WORD_SIZE);
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+FusedPattern Emulator::matchFused(const AssemblerInstruction& first, const AssemblerInstruction& second)
+{
+  switch(first.oc)
+  {
+    case OperationCodes::LD_CSR_MEM_DIR_INC: // iret
+      if(second.oc == OperationCodes::LD_REG_MEM_DIR_INC && second.regA == PC && second.regB == first.regB &&
+         first.regB != R0 && first.regB != PC)
+      {
+        return FusedPattern::IRET;
+      }
+      break;
+    case OperationCodes::LD_REG_MEM_DIR: // ucitavanje iz bazena literala
+      if(first.regB != PC || first.regC != R0 || first.regA == R0 || first.regA == PC)
+      {
+        break;
+      }
+      if(second.oc == OperationCodes::LD_REG_MEM_DIR && second.regA == first.regA && second.regB == first.regA &&
+         second.regC == R0 && second.disp == 0)
+      {
+        return FusedPattern::LOAD_MEMORY;
+      }
+      if(second.oc == OperationCodes::ST_MEM_DIR_INC && second.regC == first.regA &&
+         second.regA != R0 && second.regA != PC && second.regA != first.regA)
+      {
+        return FusedPattern::LOAD_PUSH;
+      }
+      break;
+    case OperationCodes::ST_MEM_DIR_INC: // push; push
+      if(second.oc == OperationCodes::ST_MEM_DIR_INC && second.regA == first.regA &&
+         first.regA != R0 && first.regA != PC && first.regC != first.regA && second.regC != first.regA &&
+         first.regC != PC && second.regC != PC) // PC se pri pojedinacnom izvrsavanju uvecava izmedju dva push-a
+      {
+        return FusedPattern::PUSH_PAIR;
+      }
+      break;
+    case OperationCodes::LD_REG_MEM_DIR_INC: // pop; pop
+      if(second.oc == OperationCodes::LD_REG_MEM_DIR_INC && second.regB == first.regB &&
+         first.regB != R0 && first.regB != PC && first.regA != PC && first.regA != first.regB &&
+         second.regA != first.regB)
+      {
+        return FusedPattern::POP_PAIR;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return FusedPattern::NONE;
+}
+//-----------------------------------------------------------------------------------------------------------
+void Emulator::retire(OperationCodes operationCode, bool isRedirected)
+{
+  counters.retire(operationCode);
+  cycleModel.retire(operationCode, isRedirected);
+  if(isRedirected)
+  {
+    isBlockEnd = true;
+  }
+  if(pairProfile != nullptr)
+  {
+    pairProfile->record(operationCode);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+// moze se pozivati iz niti uredjaja, prekid se obradjuje na prvoj granici bazicnog bloka
+void Emulator::raiseInterrupt(InterruptType interruptType)
+{
+  pendingInterrupts.fetch_or(toPendingBit(interruptType), std::memory_order_release);
+}
+//-----------------------------------------------------------------------------------------------------------
+// obradjuje najprioritetniji nemaskirani prekid, maskirani ostaju da cekaju
+void Emulator::handlePendingInterrupts()
+{
+  uint32_t pending = pendingInterrupts.load(std::memory_order_acquire);
+  for(InterruptType interruptType : {InterruptType::TIMER, InterruptType::TERMINAL})
+  {
+    uint32_t bit = toPendingBit(interruptType);
+    if((pending & bit) && isInterruptEnabled(interruptType))
+    {
+      pendingInterrupts.fetch_and(~bit, std::memory_order_acq_rel);
+      executeInterrupt(interruptType);
+      return;
+    }
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+// prekidna rutina se izvrsava sa maskiranim prekidima, iret vraca sacuvani status
 void Emulator::executeInterrupt(InterruptType interruptType)
 {
+  counters.interrupt(interruptType);
+  cycleModel.interruptEntry();
+  uint32_t status = context.readControl(STATUS);
   push(context.readGpr(PC));
-  push(context.readControl(STATUS));
+  push(status);
   context.writeControl(CAUSE, static_cast<uint8_t>(interruptType));
-  context.writeControl(STATUS, context.readControl(STATUS) & (~0x1));
+  writeControl(STATUS, status | STATUS_INTERRUPT_MASK);
   context.writeGpr(PC, context.readControl(HANDLER));
 }
 //-----------------------------------------------------------------------------------------------------------
+bool Emulator::isInterruptEnabled(InterruptType interruptType) const
+{
+  uint32_t status = context.readControl(STATUS);
+  if(status & STATUS_INTERRUPT_MASK)
+  {
+    return false;
+  }
+
+  switch(interruptType)
+  {
+    case InterruptType::TIMER:
+      return !(status & STATUS_TIMER_MASK);
+    case InterruptType::TERMINAL:
+      return !(status & STATUS_TERMINAL_MASK);
+    default:
+      return true;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
 void Emulator::push(uint32_t value)
 {
   context.decSP();
-  memory.writeWord(context.readGpr(SP), value);
+  writeMemory(context.readGpr(SP), value);
 }
 //-----------------------------------------------------------------------------------------------------------
 uint32_t Emulator::pop()
 {
-  uint32_t value = memory.readWord(context.readGpr(SP));
+  uint32_t value = readMemory(context.readGpr(SP));
   context.incSP();
   return value;
 }
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Emulator::readMemory(uint32_t address)
+{
+  counters.memoryRead();
+  cycleModel.memoryAccess();
+  return memory.readWord(address);
+}
+//-----------------------------------------------------------------------------------------------------------
+void Emulator::writeMemory(uint32_t address, uint32_t value)
+{
+  counters.memoryWrite();
+  cycleModel.memoryAccess();
+  memory.writeWord(address, value);
+
+  if(address == Timer::CONFIG_ADDRESS)
+  {
+    timer.configure(value, cycleModel.getCycles());
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void Emulator::writeMemoryIndirect(uint32_t address, uint32_t value)
+{
+  writeMemory(readMemory(address), value);
+}
+//-----------------------------------------------------------------------------------------------------------
+// kontrolni registri: status, handler i cause su u kontekstu, ostali su brojaci performansi
+uint32_t Emulator::readControl(uint8_t index) const
+{
+  if(index == CYCLE || index == CYCLEH)
+  {
+    uint64_t cycles = cycleModel.getCycles();
+    return static_cast<uint32_t>(index == CYCLE ? cycles : cycles >> 32);
+  }
+
+  if(index >= INSTRET)
+  {
+    return counters.readRegister(index);
+  }
+
+  return context.readControl(index);
+}
+//-----------------------------------------------------------------------------------------------------------
+// upis u status moze demaskirati prekid koji ceka, pa se prekidi proveravaju posle instrukcije
+void Emulator::writeControl(uint8_t index, uint32_t value)
+{
+  if(index == STATUS)
+  {
+    isBlockEnd = true;
+  }
+  context.writeControl(index, value);
+}
+//-----------------------------------------------------------------------------------------------------------
+void Emulator::printFusionReport() const
+{
+  std::cout << std::dec << std::setfill(' ');
+  std::cout << "===================================\n";
+  std::cout << "SPOJENE INSTRUKCIJE" << (options.fuseInstructions ? "" : " (iskljuceno)") << ":\n";
+  for(uint8_t i = 0; i < fusedCounts.size(); ++i)
+  {
+    std::cout << "  " << std::left << std::setw(20) << FUSED_PATTERN_NAMES[i] << std::right << fusedCounts[i] << "\n";
+  }
+  std::cout << "===================================\n";
+}
 
-} // namespace emulator_core
\ No newline at end of file
+} // namespace emulator_core
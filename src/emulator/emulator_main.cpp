@@ -2,18 +2,116 @@
 
 #include <common/exceptions.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 
-int main(int argc, char* argv[])
+namespace
 {
-  if(argc != 2)
-  {
-    throw common::RuntimeError("Greska! Ispravna sintaksa: ./emulator putanja_do_fajla");
-  }
 
+const std::string USAGE =
+  "Greska! Ispravna sintaksa: ./emulator [-stats] [-icache=opis] [-dcache=opis] [-ucache=opis] [-map=mapa] "
+  "[-cycles=model] [-timer=host|cycles] [-clock=frekvencija] [-nofuse] [-pairs] [-profile=izlaz] putanja_do_fajla\n"
+  "  opis kesa: velicina:asocijativnost:linija:lru|fifo|random";
+
+bool startsWith(const std::string& argument, const std::string& prefix)
+{
+  return argument.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
   try
   {
-    emulator_core::Emulator emulator(argv[1]);
+    using emulator_core::CacheConfig;
+
+    emulator_core::EmulatorOptions options;
+    emulator_core::CacheOptions& cacheOptions = options.cacheOptions;
+    std::vector<std::string> unifiedCacheDescriptions;
+    std::string inputFilePath;
+    for(int i = 1; i < argc; ++i)
+    {
+      std::string argument = argv[i];
+      if(argument == "-stats")
+      {
+        options.printStatistics = true;
+      }
+      else if(argument == "-nofuse")
+      {
+        options.fuseInstructions = false;
+      }
+      else if(argument == "-pairs")
+      {
+        options.profilePairs = true;
+      }
+      else if(startsWith(argument, "-icache="))
+      {
+        std::string name = "L" + std::to_string(cacheOptions.instructionCaches.size() + 1) + "I";
+        cacheOptions.instructionCaches.emplace_back(CacheConfig::parse(name, argument.substr(8)));
+      }
+      else if(startsWith(argument, "-dcache="))
+      {
+        std::string name = "L" + std::to_string(cacheOptions.dataCaches.size() + 1) + "D";
+        cacheOptions.dataCaches.emplace_back(CacheConfig::parse(name, argument.substr(8)));
+      }
+      else if(startsWith(argument, "-ucache="))
+      {
+        unifiedCacheDescriptions.emplace_back(argument.substr(8));
+      }
+      else if(startsWith(argument, "-map="))
+      {
+        cacheOptions.mapFilePath = argument.substr(5);
+      }
+      else if(startsWith(argument, "-profile="))
+      {
+        options.profileFilePath = argument.substr(9);
+      }
+      else if(startsWith(argument, "-cycles="))
+      {
+        options.cycleModelFilePath = argument.substr(8);
+      }
+      else if(argument == "-timer=host")
+      {
+        options.timerClock = emulator_core::TimerClock::HOST;
+      }
+      else if(argument == "-timer=cycles")
+      {
+        options.timerClock = emulator_core::TimerClock::CYCLES;
+      }
+      else if(startsWith(argument, "-clock="))
+      {
+        options.clockFrequency = std::stoull(argument.substr(7), nullptr, 0);
+        if(options.clockFrequency == 0)
+        {
+          throw common::RuntimeError(USAGE);
+        }
+      }
+      else if(inputFilePath.empty())
+      {
+        inputFilePath = argument;
+      }
+      else
+      {
+        throw common::RuntimeError(USAGE);
+      }
+    }
+
+    if(inputFilePath.empty())
+    {
+      throw common::RuntimeError(USAGE);
+    }
+
+    // zajednicki nivoi se nastavljaju ispod najdublje odvojene hijerarhije
+    size_t firstUnifiedLevel = std::max(cacheOptions.instructionCaches.size(), cacheOptions.dataCaches.size()) + 1;
+    for(const std::string& description : unifiedCacheDescriptions)
+    {
+      std::string name = "L" + std::to_string(firstUnifiedLevel + cacheOptions.unifiedCaches.size());
+      cacheOptions.unifiedCaches.emplace_back(CacheConfig::parse(name, description));
+    }
+
+    emulator_core::Emulator emulator(inputFilePath, options);
     emulator.emulate();
   }
   catch(const std::exception& e)
@@ -22,4 +120,4 @@ int main(int argc, char* argv[])
     return -1;
   }
   
-}
\ No newline at end of file
+}
@@ -1,6 +1,10 @@
 #include <emulator/memory.hpp>
 #include <common/exceptions.hpp>
 
+#ifdef EMULATOR_CACHE_SIMULATION
+#include <emulator/cache_simulator.hpp>
+#endif
+
 #include <iostream>
 #include <iomanip>
 #include <string_view>
@@ -44,11 +48,35 @@ void Memory::reset()
   memory.clear();
 }
 //-----------------------------------------------------------------------------------------------------------
+uint32_t Memory::fetchWord(uint64_t address)
+{
+#ifdef EMULATOR_CACHE_SIMULATION
+  if(cacheSimulator != nullptr)
+  {
+    cacheSimulator->fetch(address);
+  }
+#endif
+
+  return loadWord(address, "Memory::fetchWord");
+}
+//-----------------------------------------------------------------------------------------------------------
 uint32_t Memory::readWord(uint64_t address)
+{
+#ifdef EMULATOR_CACHE_SIMULATION
+  if(cacheSimulator != nullptr)
+  {
+    cacheSimulator->read(address);
+  }
+#endif
+
+  return loadWord(address, "Memory::readWord");
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t Memory::loadWord(uint64_t address, const char* methodName)
 {
   if(address + WORD_SIZE > size)
   {
-    throw common::MemoryError("Memory::readWord", std::string(MEMORY_OVERFLOW));
+    throw common::MemoryError(methodName, std::string(MEMORY_OVERFLOW));
   }
 
   uint32_t value = 0;
@@ -67,6 +95,13 @@ void Memory::writeWord(uint64_t address, uint32_t word)
     throw common::MemoryError("Memory::writeWord", std::string(MEMORY_OVERFLOW));
   }
 
+#ifdef EMULATOR_CACHE_SIMULATION
+  if(cacheSimulator != nullptr)
+  {
+    cacheSimulator->write(address);
+  }
+#endif
+
   uint8_t* bytes = reinterpret_cast<uint8_t*>(&word);
   for(uint32_t i = 0, numBytes = sizeof(word); i < numBytes; ++i)
   {
@@ -82,8 +117,8 @@ void Memory::writeWordIndirect(uint64_t address, uint32_t word)
 //-----------------------------------------------------------------------------------------------------------
 void Context::reset()
 {
-  gpr[SP] = 0; // poslednja zauzeta ?
-  gpr[PC] = 0x40000000;
+  gpr[common::SP] = 0; // poslednja zauzeta ?
+  gpr[common::PC] = 0x40000000;
 }
 //-----------------------------------------------------------------------------------------------------------
 void Context::writeGpr(uint8_t index, uint32_t value)
@@ -113,14 +148,14 @@ uint32_t Context::readGpr(uint8_t index) const
 //-----------------------------------------------------------------------------------------------------------
 uint32_t Context::readAndIncPC()
 {
-  uint32_t pc = gpr[PC];
-  gpr[PC] += 4;
+  uint32_t pc = gpr[common::PC];
+  gpr[common::PC] += 4;
   return pc;
 }
 //-----------------------------------------------------------------------------------------------------------
 void Context::writeControl(uint8_t index, uint32_t value)
 {
-  if(index > NUM_CONTROL)
+  if(index >= NUM_CONTROL)
   {
     throw common::MemoryError("Memory::readControl", std::string(INVALID_REGISTER));
   }
@@ -130,7 +165,7 @@ void Context::writeControl(uint8_t index, uint32_t value)
 //-----------------------------------------------------------------------------------------------------------
 uint32_t Context::readControl(uint8_t index) const
 {
-  if(index > NUM_CONTROL)
+  if(index >= NUM_CONTROL)
   {
     printState();
     std::cout << "INDEKS: " << (int)index << "\n";
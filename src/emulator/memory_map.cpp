@@ -0,0 +1,74 @@
+#include <emulator/memory_map.hpp>
+#include <common/map_file_processor.hpp>
+
+#include <algorithm>
+
+namespace emulator_core
+{
+
+void MemoryMap::load(const std::string& mapFilePath)
+{
+  common::MapFileData data = common::MapFileProcessor::readFromFile(mapFilePath);
+
+  sections.clear();
+  symbols.clear();
+  for(const common::MapEntry& section : data.sections)
+  {
+    sections.push_back({section.name, section.address, section.size});
+  }
+  for(const common::MapEntry& symbol : data.symbols)
+  {
+    symbols.push_back({symbol.name, symbol.address, 0});
+  }
+
+  auto byAddress = [](const MemoryRegion& region1, const MemoryRegion& region2)
+  {
+    return region1.startAddress < region2.startAddress;
+  };
+  std::sort(sections.begin(), sections.end(), byAddress);
+  std::sort(symbols.begin(), symbols.end(), byAddress);
+
+  // simbol traje do sledeceg simbola ili do kraja sekcije u kojoj se nalazi
+  for(uint32_t i = 0, numSymbols = symbols.size(); i < numSymbols; ++i)
+  {
+    MemoryRegion& symbol = symbols[i];
+    uint64_t endAddress = symbol.startAddress;
+
+    uint32_t sectionIndex = findSection(symbol.startAddress);
+    if(sectionIndex != NOT_FOUND)
+    {
+      const MemoryRegion& section = sections[sectionIndex];
+      endAddress = static_cast<uint64_t>(section.startAddress) + section.size;
+    }
+    if(i + 1 < numSymbols)
+    {
+      endAddress = std::min<uint64_t>(endAddress, symbols[i + 1].startAddress);
+    }
+
+    symbol.size = endAddress - symbol.startAddress;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t MemoryMap::find(const std::vector<MemoryRegion>& regions, uint32_t address)
+{
+  auto it = std::upper_bound(regions.begin(), regions.end(), address,
+    [](uint32_t address, const MemoryRegion& region)
+    {
+      return address < region.startAddress;
+    });
+
+  if(it == regions.begin())
+  {
+    return NOT_FOUND;
+  }
+
+  --it;
+  if(address - it->startAddress >= it->size)
+  {
+    return NOT_FOUND;
+  }
+
+  return it - regions.begin();
+}
+
+} // namespace emulator_core
@@ -0,0 +1,233 @@
+#include <emulator/performance_counters.hpp>
+#include <common/exceptions.hpp>
+#include <common/profile_file_processor.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+namespace emulator_core
+{
+
+using common::OperationCodes;
+
+const char* toString(OperationCodes operationCode)
+{
+  switch(operationCode)
+  {
+    case OperationCodes::HALT: return "HALT";
+    case OperationCodes::INT: return "INT";
+    case OperationCodes::CALL_REG_DIR: return "CALL_REG_DIR";
+    case OperationCodes::CALL_REG_IND: return "CALL_REG_IND";
+    case OperationCodes::JMP_IMM: return "JMP_IMM";
+    case OperationCodes::BEQ_IMM: return "BEQ_IMM";
+    case OperationCodes::BNE_IMM: return "BNE_IMM";
+    case OperationCodes::BGT_IMM: return "BGT_IMM";
+    case OperationCodes::JMP_MEM_DIR: return "JMP_MEM_DIR";
+    case OperationCodes::BEQ_MEM_DIR: return "BEQ_MEM_DIR";
+    case OperationCodes::BNE_MEM_DIR: return "BNE_MEM_DIR";
+    case OperationCodes::BGT_MEM_DIR: return "BGT_MEM_DIR";
+    case OperationCodes::XCHG: return "XCHG";
+    case OperationCodes::ADD: return "ADD";
+    case OperationCodes::SUB: return "SUB";
+    case OperationCodes::MUL: return "MUL";
+    case OperationCodes::DIV: return "DIV";
+    case OperationCodes::NOT: return "NOT";
+    case OperationCodes::AND: return "AND";
+    case OperationCodes::OR: return "OR";
+    case OperationCodes::XOR: return "XOR";
+    case OperationCodes::SHL: return "SHL";
+    case OperationCodes::SHR: return "SHR";
+    case OperationCodes::ST_MEM_DIR: return "ST_MEM_DIR";
+    case OperationCodes::ST_MEM_IND: return "ST_MEM_IND";
+    case OperationCodes::ST_MEM_DIR_INC: return "ST_MEM_DIR_INC";
+    case OperationCodes::LD_REG_CSR: return "LD_REG_CSR";
+    case OperationCodes::LD_REG_IMM: return "LD_REG_IMM";
+    case OperationCodes::LD_REG_MEM_DIR: return "LD_REG_MEM_DIR";
+    case OperationCodes::LD_REG_MEM_DIR_INC: return "LD_REG_MEM_DIR_INC";
+    case OperationCodes::LD_CSR_REG: return "LD_CSR_REG";
+    case OperationCodes::LD_CSR_OR: return "LD_CSR_OR";
+    case OperationCodes::LD_CSR_MEM_DIR: return "LD_CSR_MEM_DIR";
+    case OperationCodes::LD_CSR_MEM_DIR_INC: return "LD_CSR_MEM_DIR_INC";
+    default: return "UNKNOWN";
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+const char* toString(InterruptType interruptType)
+{
+  switch(interruptType)
+  {
+    case InterruptType::ERROR: return "ERROR";
+    case InterruptType::TIMER: return "TIMER";
+    case InterruptType::TERMINAL: return "TERMINAL";
+    case InterruptType::SOFTWARE: return "SOFTWARE";
+    default: return "UNKNOWN";
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void PerformanceCounters::start()
+{
+  startTime = std::chrono::steady_clock::now();
+  isStopped = false;
+}
+//-----------------------------------------------------------------------------------------------------------
+void PerformanceCounters::stop()
+{
+  stopTime = std::chrono::steady_clock::now();
+  isStopped = true;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint64_t PerformanceCounters::getHostTimeMicroseconds() const
+{
+  auto endTime = isStopped ? stopTime : std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t PerformanceCounters::readRegister(uint8_t index) const
+{
+  switch(index)
+  {
+    case common::INSTRET:
+      return static_cast<uint32_t>(instructionsRetired);
+    case common::INSTRETH:
+      return static_cast<uint32_t>(instructionsRetired >> 32);
+    case common::BRTAKEN:
+      return static_cast<uint32_t>(branchesTaken);
+    case common::BRNOTTAKEN:
+      return static_cast<uint32_t>(branchesNotTaken);
+    case common::MEMRD:
+      return static_cast<uint32_t>(memoryReads);
+    case common::MEMWR:
+      return static_cast<uint32_t>(memoryWrites);
+    case common::INTCNT:
+    {
+      uint64_t total = 0;
+      for(uint64_t count : interrupts)
+      {
+        total += count;
+      }
+      return static_cast<uint32_t>(total);
+    }
+    case common::HOSTTIME:
+      return static_cast<uint32_t>(getHostTimeMicroseconds());
+    default:
+      throw common::MemoryError("PerformanceCounters::readRegister", "Pokusaj pristupu nepostojecem registru!");
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void PerformanceCounters::printReport() const
+{
+  uint64_t hostTime = getHostTimeMicroseconds();
+
+  std::cout << std::dec << std::setfill(' ');
+  std::cout << "===================================\n";
+  std::cout << "STATISTIKA IZVRSAVANJA:\n";
+  std::cout << "Izvrsene instrukcije: " << instructionsRetired << "\n";
+  std::cout << "Vreme na domacinu: " << hostTime << " us\n";
+  if(hostTime != 0)
+  {
+    std::cout << "Brzina emulacije: " << std::fixed << std::setprecision(2)
+              << static_cast<double>(instructionsRetired) / hostTime << " MIPS\n";
+  }
+  std::cout << "Grananja (skok/bez skoka): " << branchesTaken << "/" << branchesNotTaken << "\n";
+  std::cout << "Citanja/upisi podataka: " << memoryReads << "/" << memoryWrites << "\n";
+
+  std::cout << "-----------------------------------\n";
+  std::cout << "Prekidi:\n";
+  for(uint8_t i = static_cast<uint8_t>(InterruptType::ERROR); i < NUM_INTERRUPT_TYPES; ++i)
+  {
+    std::cout << "  " << std::left << std::setw(20) << toString(static_cast<InterruptType>(i))
+              << std::right << interrupts[i] << "\n";
+  }
+
+  std::cout << "-----------------------------------\n";
+  std::cout << "Instrukcije po kodu operacije:\n";
+  for(uint32_t i = 0, numCodes = opcodeCounts.size(); i < numCodes; ++i)
+  {
+    if(opcodeCounts[i] == 0)
+    {
+      continue;
+    }
+
+    double percentage = 100.0 * opcodeCounts[i] / instructionsRetired;
+    std::cout << "  " << std::left << std::setw(20) << toString(static_cast<OperationCodes>(i))
+              << std::right << std::setw(12) << opcodeCounts[i]
+              << std::fixed << std::setprecision(2) << std::setw(8) << percentage << "%\n";
+  }
+  std::cout << "===================================\n";
+}
+//-----------------------------------------------------------------------------------------------------------
+void InstructionPairProfile::printReport(uint32_t numPairs) const
+{
+  uint64_t totalPairs = 0;
+  std::vector<uint32_t> pairs;
+  for(uint32_t i = 0, numCounts = pairCounts.size(); i < numCounts; ++i)
+  {
+    if(pairCounts[i] != 0)
+    {
+      pairs.push_back(i);
+      totalPairs += pairCounts[i];
+    }
+  }
+
+  numPairs = std::min<uint32_t>(numPairs, pairs.size());
+  std::partial_sort(pairs.begin(), pairs.begin() + numPairs, pairs.end(),
+    [this](uint32_t pair1, uint32_t pair2)
+    {
+      return pairCounts[pair1] != pairCounts[pair2] ? pairCounts[pair1] > pairCounts[pair2] : pair1 < pair2;
+    });
+
+  std::cout << std::dec << std::setfill(' ');
+  std::cout << "===================================\n";
+  std::cout << "NAJCESCI PAROVI INSTRUKCIJA:\n";
+  for(uint32_t i = 0; i < numPairs; ++i)
+  {
+    uint32_t pair = pairs[i];
+    double percentage = 100.0 * pairCounts[pair] / totalPairs;
+    std::cout << "  " << std::left << std::setw(20) << toString(static_cast<OperationCodes>(pair / 256))
+              << std::setw(20) << toString(static_cast<OperationCodes>(pair % 256))
+              << std::right << std::setw(12) << pairCounts[pair]
+              << std::fixed << std::setprecision(2) << std::setw(8) << percentage << "%\n";
+  }
+  std::cout << "===================================\n";
+}
+//-----------------------------------------------------------------------------------------------------------
+SectionProfile::SectionProfile(const std::string& mapFilePath)
+{
+  memoryMap.load(mapFilePath);
+  sectionCounts.assign(memoryMap.getSections().size(), 0);
+}
+//-----------------------------------------------------------------------------------------------------------
+void SectionProfile::findSection(uint32_t pc)
+{
+  uint32_t sectionIndex = memoryMap.findSection(pc);
+  if(sectionIndex == MemoryMap::NOT_FOUND)
+  {
+    currentSize = 0; // sledeca instrukcija ponovo trazi sekciju
+    currentCount = &unmappedCount;
+    return;
+  }
+
+  const MemoryRegion& section = memoryMap.getSections()[sectionIndex];
+  currentStart = section.startAddress;
+  currentSize = section.size;
+  currentCount = &sectionCounts[sectionIndex];
+}
+//-----------------------------------------------------------------------------------------------------------
+void SectionProfile::writeToFile(const std::string& filePath) const
+{
+  std::vector<common::ProfileEntry> entries;
+  const std::vector<MemoryRegion>& sections = memoryMap.getSections();
+  for(uint32_t i = 0, numSections = sections.size(); i < numSections; ++i)
+  {
+    entries.push_back({sections[i].name, sectionCounts[i]});
+  }
+  common::ProfileFileProcessor::writeToFile(entries, filePath);
+
+  if(unmappedCount != 0)
+  {
+    std::cout << "Profil: " << std::dec << unmappedCount << " instrukcija van poznatih sekcija\n";
+  }
+}
+
+} // namespace emulator_core
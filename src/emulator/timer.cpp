@@ -0,0 +1,74 @@
+#include <emulator/timer.hpp>
+
+#include <array>
+
+namespace
+{
+
+// tim_cfg -> period u milisekundama
+constexpr std::array<uint32_t, 8> TIMER_PERIODS = {500, 1000, 1500, 2000, 5000, 10000, 30000, 60000};
+constexpr uint32_t HOST_POLL_INTERVAL = 1024; // broj instrukcija izmedju dva citanja vremena domacina
+
+} // namespace
+
+namespace emulator_core
+{
+
+Timer::Timer(TimerClock clock, uint64_t clockFrequency)
+  : clock(clock), clockFrequency(clockFrequency) {}
+//-----------------------------------------------------------------------------------------------------------
+void Timer::start(uint64_t cycles)
+{
+  startTime = std::chrono::steady_clock::now();
+  configure(0, cycles);
+}
+//-----------------------------------------------------------------------------------------------------------
+void Timer::configure(uint32_t config, uint64_t cycles)
+{
+  period = toTicks(TIMER_PERIODS[config % TIMER_PERIODS.size()]);
+  nextDeadline = now(cycles) + period;
+}
+//-----------------------------------------------------------------------------------------------------------
+bool Timer::update(uint64_t cycles)
+{
+  if(clock == TimerClock::HOST)
+  {
+    if(--pollCountdown != 0)
+    {
+      return false;
+    }
+    pollCountdown = HOST_POLL_INTERVAL;
+  }
+
+  uint64_t currentTime = now(cycles);
+  if(currentTime < nextDeadline)
+  {
+    return false;
+  }
+
+  nextDeadline = currentTime + period;
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint64_t Timer::now(uint64_t cycles) const
+{
+  if(clock == TimerClock::CYCLES)
+  {
+    return cycles;
+  }
+
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+//-----------------------------------------------------------------------------------------------------------
+uint64_t Timer::toTicks(uint32_t milliseconds) const
+{
+  if(clock == TimerClock::CYCLES)
+  {
+    return milliseconds * clockFrequency / 1000;
+  }
+
+  return static_cast<uint64_t>(milliseconds) * 1000;
+}
+
+} // namespace emulator_core
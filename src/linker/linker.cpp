@@ -1,34 +1,72 @@
 #include <linker/linker.hpp>
 
+#include <common/archive_file_processor.hpp>
 #include <common/executable_file_processor.hpp>
+#include <common/map_file_processor.hpp>
 #include <common/object_file_processor.hpp>
+#include <common/profile_file_processor.hpp>
 #include <common/exceptions.hpp>
+#include <common/hash.hpp>
+#include <common/link_state_file_processor.hpp>
+#include <common/thread_pool.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
 #include <unordered_set>
 
 namespace
 {
 constexpr uint32_t INVALID_SECTION = 0;
+constexpr uint64_t MIN_PARALLEL_RELOCATIONS = 16384; // ispod ovoga pokretanje niti kosta vise od prepravljanja
 
-std::vector<lnk_core::GlobalSectionData> toVector(
-  std::unordered_map<std::string, lnk_core::GlobalSectionData> globalSectionDataMap)
+constexpr uint64_t MMIO_START = 0xFFFFFF00; // memorijski mapirani registri, linker ih ne dodeljuje sekcijama
+constexpr uint64_t MMIO_END = 0x100000000;
+constexpr uint64_t ADDRESS_SPACE_END = 0x100000000;
+constexpr uint32_t DEFAULT_REGION = 0; // prva navedena oblast ili ceo adresni prostor
+constexpr uint32_t RESET_ADDRESS = 0x40000000; // emulator pocinje izvrsavanje sa ove adrese
+constexpr uint64_t PAGE_SIZE = 4096; // za procenu lokalnosti koda po profilu
+
+uint64_t alignUp(uint64_t address, uint32_t alignment)
+{
+  return (address + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+}
+
+// indeksi sekcija sortirani po pocetnoj adresi
+std::vector<uint32_t> sortByAddress(const std::vector<lnk_core::GlobalSectionData>& sections)
 {
   using namespace lnk_core;
 
-  std::vector<GlobalSectionData> sectionVector;
-  for (const auto& [_, globalSectionData] : globalSectionDataMap)
+  std::vector<uint32_t> order(sections.size());
+  for(uint32_t i = 0, numSections = sections.size(); i < numSections; ++i)
   {
-    sectionVector.emplace_back(globalSectionData);
+    order[i] = i;
   }
 
-  std::sort(sectionVector.begin(), sectionVector.end(),
-    [](const GlobalSectionData& data1, const GlobalSectionData& data2)
+  std::stable_sort(order.begin(), order.end(),
+    [&sections](uint32_t section1, uint32_t section2)
     {
-      return data1.startAddress < data2.startAddress;
+      return sections[section1].startAddress < sections[section2].startAddress;
     });
 
-  return sectionVector;
+  return order;
+}
+//---------------------------------------------------------------------------------------------------------------------
+std::string readFile(const std::string& filePath)
+{
+  std::ifstream inFile(filePath, std::ios::binary);
+  if(!inFile.is_open())
+  {
+    throw common::RuntimeError("Fajl na putanji " + filePath + " nije mogao biti otvoren!");
+  }
+
+  std::stringstream content;
+  content << inFile.rdbuf();
+  return content.str();
 }
 
 } // namespace
@@ -39,222 +77,1360 @@ namespace lnk_core
 Linker::Linker(
         const std::vector<SectionPlacement>& sectionPlacements,
         const std::vector<std::string>& inputFilePaths,
-        const std::string& outputFilePath)
-        : sectionPlacements(sectionPlacements), inputFilePaths(inputFilePaths), outputFilePath(outputFilePath)
+        const std::string& outputFilePath,
+        const LinkerOptions& options)
+        : sectionPlacements(sectionPlacements), inputFilePaths(inputFilePaths), outputFilePath(outputFilePath),
+          options(options)
 {}
 //---------------------------------------------------------------------------------------------------------------------
+Linker::Linker(
+        const std::vector<SectionPlacement>& sectionPlacements,
+        std::vector<LinkerInputData> inputData,
+        const std::vector<std::string>& inputNames,
+        const std::string& outputFilePath,
+        const LinkerOptions& options)
+        : Linker(sectionPlacements, inputNames, outputFilePath, options)
+{
+  if(options.incremental)
+  {
+    throw LinkerError("Inkrementalno linkovanje zahteva ulazne fajlove!");
+  }
+  objectFilesData = std::move(inputData);
+  hasInputData = true;
+}
+//---------------------------------------------------------------------------------------------------------------------
 void Linker::performLinking()
 {
+  phaseStart = std::chrono::steady_clock::now();
+  if(options.relocatable)
+  {
+    performRelocatableLinking();
+    return;
+  }
+  if(options.incremental)
+  {
+    if(performIncrementalLinking())
+    {
+      return;
+    }
+    *options.log << "Inkrementalno linkovanje nije moguce, radi se potpuno linkovanje\n";
+  }
+
   readInputFiles();
+  endPhase("citanje");
+  if(options.gcSections)
+  {
+    removeUnreachableSections();
+    endPhase("uklanjanje sekcija");
+  }
   
   processProgramSections();
-
-  if(!isPlacingSectionsPossible())
+  if(options.incremental)
   {
-    throw LinkerError("Nije moguce smestiti sekcije na navedenim adresama!");
+    recordInputSections();
   }
+
+  checkFixedPlacements();
   findSectionsStartAddress();
+  buildOutputImage();
+  endPhase("smestanje sekcija");
   initGlobalSymbolTable();
+  resolveSymbols();
+  endPhase("razresavanje simbola");
   patchRelocationEntries();
+  endPhase("relokacije");
 
   // kraj linkovanja
-  ExecutableFileProcessor::writeToFile(toVector(globalSectionDataMap), outputFilePath);
+  writeOutputFiles();
+  endPhase("upis");
   printLinkingInfo();
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::readInputFiles()
+// Ako su se u odnosu na sacuvano stanje promenili samo sadrzaji sekcija i relokacije objektnih fajlova (tabele
+// simbola su iste), raspored sekcija i globalni simboli ostaju isti. Tada se u sacuvanu izlaznu sliku kopiraju
+// samo delovi izmenjenih fajlova i prepravljaju samo njihove relokacije, sto daje isti izlaz kao potpuno linkovanje.
+// Vraca false ako to nije moguce.
+bool Linker::performIncrementalLinking()
 {
-  for(const std::string& inputFilePath : inputFilePaths)
+  LinkState state;
+  if(!LinkStateFileProcessor::readFromFile(getLinkStatePath(), state) || state.optionsHash != getOptionsHash() ||
+     state.inputs.size() != inputFilePaths.size())
   {
-    objectFilesData.emplace_back(ObjectFileProcessor::readFromFile(inputFilePath));
+    return false;
   }
-}
-//---------------------------------------------------------------------------------------------------------------------
-// Spaja kod istoimenih sekcija.
-// popunjava mapu sa velicinama  sekcija i vektor sa redosledom sekcija.
-// Radi update tabela simbola gde ce nova vrednost simbola biti njihova adresa u memoriji
-void Linker::processProgramSections()
-{
-  for(auto& data : objectFilesData)
+
+  std::vector<uint32_t> changedInputs;
+  std::vector<LinkerInputData> changedData;
+  for(uint32_t i = 0, numInputs = inputFilePaths.size(); i < numInputs; ++i)
   {
-    for(int i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    std::string content = readFile(inputFilePaths[i]);
+    uint64_t contentHash = fnv1a(content);
+    if(contentHash == state.inputs[i].contentHash)
     {
-      Symbol& symbol = data.symbolTable[i];
-      if(i != symbol.sectionNumber) // nije sekcija
+      continue;
+    }
+    if(state.inputs[i].layoutHash == 0 || ArchiveFileProcessor::isArchive(inputFilePaths[i])) // arhiva
+    {
+      return false;
+    }
+
+    LinkerInputData data = ObjectFileProcessor::readFromBuffer(content);
+    if(getLayoutHash(data) != state.inputs[i].layoutHash)
+    {
+      return false;
+    }
+    state.inputs[i].contentHash = contentHash;
+    changedInputs.push_back(i);
+    changedData.emplace_back(std::move(data));
+  }
+
+  uint64_t imageSize = 0;
+  for(const LinkStateSection& section : state.sections)
+  {
+    if(static_cast<uint64_t>(section.imageOffset) + section.size > state.image.size())
+    {
+      return false;
+    }
+    imageSize += section.size;
+  }
+  if(imageSize != state.image.size())
+  {
+    return false;
+  }
+
+  // delovi izlaznih sekcija ostaju isti, proverava se samo da li sacuvano stanje odgovara fajlu
+  for(uint32_t k = 0, numChanged = changedInputs.size(); k < numChanged; ++k)
+  {
+    LinkerInputData& data = changedData[k];
+    data.globalSectionIds.assign(data.symbolTable.size(), INVALID_NUMBER);
+    if(options.gcSections)
+    {
+      data.isLiveSection.assign(data.symbolTable.size(), false);
+    }
+
+    for(const LinkStateInputSection& inputSection : state.inputs[changedInputs[k]].sections)
+    {
+      uint32_t sectionNumber = inputSection.sectionNumber;
+      if(sectionNumber >= data.symbolTable.size() || data.symbolTable[sectionNumber].sectionNumber != sectionNumber ||
+         inputSection.globalSectionId >= state.sections.size())
       {
-        continue;
+        return false;
       }
 
-      const std::string& sectionName = symbol.name;
-      GlobalSectionData& sectionData = globalSectionDataMap[sectionName];
-      if(sectionData.size == INVALID_NUMBER) // sekcija se prvi put dodaje
+      Symbol& section = data.symbolTable[sectionNumber];
+      const std::vector<uint8_t>& bytes = data.sectionMemoryMap[sectionNumber];
+      if(bytes.size() != section.size ||
+         static_cast<uint64_t>(inputSection.offset) + section.size > state.sections[inputSection.globalSectionId].size)
       {
-        sectionOrder.emplace_back(sectionName);
-        sectionData.size = 0;
+        return false;
+      }
+
+      section.value = inputSection.offset;
+      data.globalSectionIds[sectionNumber] = inputSection.globalSectionId;
+      if(options.gcSections)
+      {
+        data.isLiveSection[sectionNumber] = true;
       }
-      // adresa sekcije u odnosu na druge istoimene sekcije. Kasnije cemo dodati i pocetnu adresu sekcija
-      symbol.value = sectionData.size;
-      sectionData.size += symbol.size; // povecavanje velicine spojenih istoimenih sekcija
-      sectionData.generatedCode.writeBytes(data.sectionMemoryMap[i]);
     }
   }
-}
-//---------------------------------------------------------------------------------------------------------------------
-// Vraca true ako je moguce da se sekcije stave na predefinisane pozicije, inace false
-bool Linker::isPlacingSectionsPossible()
-{
-  uint32_t numPlacements = sectionPlacements.size();
-  for(int i = 0; i < numPlacements; ++i)
+
+  for(const LinkStateSection& section : state.sections)
+  {
+    globalSectionIds.emplace(section.name, globalSections.size());
+    globalSections.push_back({section.name, {}, section.imageOffset, section.startAddress, section.size});
+  }
+  for(const LinkStateSymbol& symbol : state.symbols)
   {
-    const SectionPlacement& placementI = sectionPlacements[i];
-    uint32_t startI = placementI.startAddress;
-    uint32_t endI = startI + globalSectionDataMap[placementI.sectionName].size;
+    globalSymbolIds.emplace(symbol.name, globalSymbols.size());
+    globalSymbols.push_back({symbol.name, symbol.value});
+  }
+  outputImage = std::move(state.image);
+  inputStates = std::move(state.inputs);
+  objectFilesData = std::move(changedData);
 
-    for(int j = i + 1; j < numPlacements; ++j)
+  for(LinkerInputData& data : objectFilesData)
+  {
+    for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
     {
-      const SectionPlacement& placementJ = sectionPlacements[j];
-      uint32_t startJ = placementJ.startAddress;
-      uint32_t endJ = startJ + globalSectionDataMap[placementJ.sectionName].size;
-
-      if(startI < endJ && endI > startJ)
+      uint32_t sectionId = data.globalSectionIds[i];
+      if(sectionId != INVALID_NUMBER)
       {
-        return false;
+        const std::vector<uint8_t>& bytes = data.sectionMemoryMap[i];
+        std::copy(bytes.begin(), bytes.end(),
+                  outputImage.begin() + globalSections[sectionId].imageOffset + data.symbolTable[i].value);
       }
     }
+    data.sectionMemoryMap.clear();
   }
+  endPhase("citanje");
+
+  *options.log << "Inkrementalno linkovanje, izmenjeni ulazni fajlovi: " << std::dec << changedInputs.size()
+            << "/" << inputFilePaths.size() << "\n";
+
+  resolveSymbols();
+  patchRelocationEntries();
+  endPhase("relokacije");
+
+  writeOutputFiles();
+  endPhase("upis");
+  printLinkingInfo();
 
   return true;
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::findSectionsStartAddress()
+// -relocatable: istoimene sekcije se spajaju kao pri potpunom linkovanju, ali se ne smestaju na adrese.
+// Izlaz je objektni fajl koji se kasnije linkuje kao i izlaz asemblera.
+void Linker::performRelocatableLinking()
 {
-  uint32_t firstFreeAddress = 0;
+  readInputFiles();
+  endPhase("citanje");
+  processProgramSections();
+  writeRelocatableObject();
+  endPhase("upis");
 
-  std::unordered_set<std::string> arrangedSections; 
-  for(auto& placement : sectionPlacements)
+  *options.log << "Relokatibilni objektni fajl " << outputFilePath << ": ulaznih fajlova " << std::dec
+            << objectFilesData.size() << ", sekcija " << globalSections.size() << "\n";
+  if(options.printTimings)
   {
-    GlobalSectionData& sectionData = globalSectionDataMap[placement.sectionName];
-    sectionData.startAddress = placement.startAddress;
-    firstFreeAddress = std::max(firstFreeAddress, sectionData.startAddress + sectionData.size);
-
-    arrangedSections.insert(placement.sectionName);
-
-    std::cout << placement.sectionName << " " << placement.startAddress << "\n";
+    printPhaseTimes();
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::endPhase(const char* name)
+{
+  auto now = std::chrono::steady_clock::now();
+  uint64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart).count();
+  phaseTimes.push_back({name, microseconds});
+  phaseStart = now;
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::readInputFiles()
+{
+  if(hasInputData)
+  {
+    return;
   }
 
-  for(std::string& sectionName : sectionOrder)
+  std::vector<ArchiveIndex> archives;
+  for(const std::string& inputFilePath : inputFilePaths)
   {
-    if(arrangedSections.find(sectionName) != arrangedSections.end()) // sekcija ima predefinisanu adresu
+    bool isArchive = ArchiveFileProcessor::isArchive(inputFilePath);
+    if(isArchive)
+    {
+      archives.emplace_back(ArchiveFileProcessor::readIndex(inputFilePath));
+    }
+
+    if(!options.incremental)
     {
+      if(!isArchive)
+      {
+        objectFilesData.emplace_back(ObjectFileProcessor::readFromFile(inputFilePath));
+      }
       continue;
     }
 
-    GlobalSectionData& sectionData = globalSectionDataMap[sectionName];
-    sectionData.startAddress = firstFreeAddress;
-    firstFreeAddress += sectionData.size;
+    // fajl se cita jednom, za hes i za parsiranje
+    std::string content = readFile(inputFilePath);
+    inputStates.push_back({inputFilePath, fnv1a(content), 0, {}});
+    if(!isArchive)
+    {
+      objectFilesData.emplace_back(ObjectFileProcessor::readFromBuffer(content));
+      inputStates.back().layoutHash = getLayoutHash(objectFilesData.back());
+    }
+  }
+
+  if(!archives.empty())
+  {
+    loadArchiveMembers(archives);
   }
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::initGlobalSymbolTable()
+// Iz arhiva ucitava samo clanove koji definisu trenutno nedefinisane simbole. Ponavlja se dok se skup
+// nedefinisanih simbola menja, pa redosled arhiva i zavisnosti izmedju clanova nisu bitni.
+void Linker::loadArchiveMembers(const std::vector<ArchiveIndex>& archives)
 {
-  for(const auto& data : objectFilesData)
+  std::unordered_set<std::string> definedSymbols;
+  std::set<std::string> undefinedSymbols; // sortirano, zbog deterministickog redosleda ucitavanja
+  auto addSymbols = [&definedSymbols, &undefinedSymbols](const LinkerInputData& data)
   {
-    for(int i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
     {
       const Symbol& symbol = data.symbolTable[i];
-      
-      // obradjujemo samo simbole koje izvozimo iz tabele simbola
-      if(symbol.sectionNumber == i || symbol.isExtern || !symbol.isGlobal)
+      if(symbol.sectionNumber != i && symbol.isGlobal && !symbol.isExtern)
       {
-        continue;
+        definedSymbols.insert(symbol.name);
+        undefinedSymbols.erase(symbol.name);
       }
-
-      if(globalSymbolTable.find(symbol.name) != globalSymbolTable.end())
+    }
+    for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      if(symbol.sectionNumber != i && symbol.isExtern && definedSymbols.count(symbol.name) == 0)
       {
-        throw LinkerError("Redeklaracija simbola " + symbol.name);
+        undefinedSymbols.insert(symbol.name);
       }
+    }
+  };
 
-      const Symbol& section = data.symbolTable[symbol.sectionNumber];
-      const auto& globalSectionData = globalSectionDataMap[section.name];
+  for(const LinkerInputData& data : objectFilesData)
+  {
+    addSymbols(data);
+  }
 
-      // pocetna adresa segmenta sekcija + pocetak dela te sekcije za ovaj fajl 
-      uint32_t sectionOffset = globalSectionData.startAddress + section.value;
-      globalSymbolTable[symbol.name] = symbol.value + sectionOffset;
-    }  
+  std::vector<std::vector<bool>> isLoaded;
+  uint32_t numMembers = 0, numLoadedMembers = 0;
+  for(const ArchiveIndex& archive : archives)
+  {
+    isLoaded.emplace_back(archive.members.size(), false);
+    numMembers += archive.members.size();
+  }
+
+  bool isChanged = true;
+  while(isChanged && !undefinedSymbols.empty())
+  {
+    isChanged = false;
+    for(uint32_t a = 0, numArchives = archives.size(); a < numArchives; ++a)
+    {
+      std::vector<std::string> pendingSymbols(undefinedSymbols.begin(), undefinedSymbols.end());
+      for(const std::string& symbolName : pendingSymbols)
+      {
+        auto memberIter = archives[a].symbolIndex.find(symbolName);
+        if(memberIter == archives[a].symbolIndex.end() || isLoaded[a][memberIter->second])
+        {
+          continue;
+        }
+
+        isLoaded[a][memberIter->second] = true;
+        objectFilesData.emplace_back(ArchiveFileProcessor::readMember(archives[a], memberIter->second));
+        addSymbols(objectFilesData.back());
+        ++numLoadedMembers;
+        isChanged = true;
+      }
+    }
   }
+
+  *options.log << "Ucitani clanovi arhiva: " << std::dec << numLoadedMembers << "/" << numMembers << "\n";
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::patchRelocationEntries()
+// -gc-sections: obilazi graf ulaznih sekcija (fajl, sekcija) po relokacijama, od sekcija smestenih na adresu
+// pokretanja i sekcija iz -root opcija. Nedostupne sekcije se ne spajaju, ne izvoze simbole i ne prepravljaju.
+void Linker::removeUnreachableSections()
 {
-  for(const auto& data : objectFilesData)
+  using InputSection = std::pair<uint32_t, uint32_t>; // indeks fajla, broj sekcije u tabeli simbola
+
+  std::unordered_map<std::string, InputSection> definitions;
+  for(uint32_t k = 0, numFiles = objectFilesData.size(); k < numFiles; ++k)
   {
-    for(const auto& [sectionUsageNumber, relocationEntries] : data.sectionRelocationMap)
+    const auto& symbolTable = objectFilesData[k].symbolTable;
+    for(uint32_t i = 0, tableSize = symbolTable.size(); i < tableSize; ++i)
     {
-      for(const RelocationEntry& entry : relocationEntries)
+      const Symbol& symbol = symbolTable[i];
+      if(symbol.sectionNumber != i && symbol.isGlobal && !symbol.isExtern)
       {
-        // oc za trenutni skup instrukcija nije bitan (sve upisujemo na 4B)
-        const Symbol& reference = data.symbolTable[entry.symbolTableReference];
+        definitions.emplace(symbol.name, InputSection(k, symbol.sectionNumber));
+      }
+    }
+  }
 
-        uint32_t symbolValue;
-        if(entry.symbolTableReference == reference.sectionNumber) // sekcija
-        {
-          const auto& globalSectionData = globalSectionDataMap[reference.name];
-          symbolValue = globalSectionData.startAddress + reference.value;
-        }
-        else // globalni simbol
-        {
-          if(globalSymbolTable.find(reference.name) == globalSymbolTable.end())
-          {
-            throw LinkerError("Upotrebljen nepostojeci simbol " + reference.name);
-          }
-          symbolValue = globalSymbolTable[reference.name];
-        }
+  std::unordered_set<std::string> rootNames(options.gcRoots.begin(), options.gcRoots.end());
+  for(const SectionPlacement& placement : sectionPlacements)
+  {
+    if(placement.regionName.empty() && placement.startAddress == RESET_ADDRESS)
+    {
+      rootNames.insert(placement.sectionName);
+    }
+  }
+
+  std::vector<InputSection> worklist;
+  auto markLive = [this, &worklist](uint32_t fileIndex, uint32_t sectionNumber)
+  {
+    std::vector<bool>& isLiveSection = objectFilesData[fileIndex].isLiveSection;
+    if(!isLiveSection[sectionNumber])
+    {
+      isLiveSection[sectionNumber] = true;
+      worklist.emplace_back(fileIndex, sectionNumber);
+    }
+  };
+
+  for(uint32_t k = 0, numFiles = objectFilesData.size(); k < numFiles; ++k)
+  {
+    const auto& symbolTable = objectFilesData[k].symbolTable;
+    objectFilesData[k].isLiveSection.assign(symbolTable.size(), false);
+    for(uint32_t i = 1, tableSize = symbolTable.size(); i < tableSize; ++i)
+    {
+      if(symbolTable[i].sectionNumber == i && rootNames.count(symbolTable[i].name) != 0)
+      {
+        markLive(k, i);
+      }
+    }
+  }
+  if(worklist.empty())
+  {
+    throw LinkerError("Za -gc-sections nije pronadjena nijedna koren sekcija (sekcija na 0x40000000 ili -root)!");
+  }
+
+  while(!worklist.empty())
+  {
+    auto [fileIndex, sectionNumber] = worklist.back();
+    worklist.pop_back();
+
+    const LinkerInputData& data = objectFilesData[fileIndex];
+    auto relocationsIter = data.sectionRelocationMap.find(sectionNumber);
+    if(relocationsIter == data.sectionRelocationMap.end())
+    {
+      continue;
+    }
+
+    for(const RelocationEntry& entry : relocationsIter->second)
+    {
+      const Symbol& reference = data.symbolTable[entry.symbolTableReference];
+      if(reference.sectionNumber == entry.symbolTableReference) // sekcija iz istog fajla
+      {
+        markLive(fileIndex, entry.symbolTableReference);
+        continue;
+      }
+
+      auto definitionIter = definitions.find(reference.name);
+      if(definitionIter != definitions.end()) // nedefinisani simboli se prijavljuju pri razresavanju
+      {
+        markLive(definitionIter->second.first, definitionIter->second.second);
+      }
+    }
+  }
 
-        const Symbol& sectionUsage = data.symbolTable[sectionUsageNumber];
+  uint32_t numRemovedSections = 0;
+  uint64_t removedSize = 0;
+  std::unordered_set<std::string> liveSectionNames;
+  for(const LinkerInputData& data : objectFilesData)
+  {
+    for(uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      if(symbol.sectionNumber != i)
+      {
+        continue;
+      }
+      if(data.isLiveSection[i])
+      {
+        liveSectionNames.insert(symbol.name);
+      }
+      else
+      {
+        ++numRemovedSections;
+        removedSize += symbol.size;
+      }
+    }
+  }
 
-        // mem[sectionUsageStartAddr + offset] = symbolValue
-        auto& globalSectionData = globalSectionDataMap[sectionUsage.name];
-        // memorija je samo za trenutne sekcije sa ovim imenom pa uzimamo offset za sekciju u ovom fajlu + offset do koriscenja
-        uint32_t fixAddr = sectionUsage.value + entry.offset;
-        globalSectionData.generatedCode.addToAddress(fixAddr, symbolValue);
+  // -place za potpuno uklonjene sekcije se zanemaruje, nepostojece sekcije se i dalje prijavljuju
+  std::unordered_set<std::string> removedSectionNames;
+  for(const LinkerInputData& data : objectFilesData)
+  {
+    for(uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const std::string& sectionName = data.symbolTable[i].name;
+      if(data.symbolTable[i].sectionNumber == i && liveSectionNames.count(sectionName) == 0)
+      {
+        removedSectionNames.insert(sectionName);
       }
     }
+  }
+  sectionPlacements.erase(std::remove_if(sectionPlacements.begin(), sectionPlacements.end(),
+    [&removedSectionNames](const SectionPlacement& placement)
+    {
+      return removedSectionNames.count(placement.sectionName) != 0;
+    }), sectionPlacements.end());
+
+  *options.log << "Uklonjene nedostupne sekcije: " << std::dec << numRemovedSections
+            << " (" << removedSize << " bajtova)\n";
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Spaja kod istoimenih sekcija.
+// Dodeljuje globalne indekse sekcijama po redosledu pojavljivanja i popunjava njihove velicine.
+// Radi update tabela simbola gde ce nova vrednost simbola biti njihova adresa u memoriji
+void Linker::processProgramSections()
+{
+  for(auto& data : objectFilesData)
+  {
+    data.globalSectionIds.assign(data.symbolTable.size(), INVALID_NUMBER);
+    for(int i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      Symbol& symbol = data.symbolTable[i];
+      if(i != symbol.sectionNumber || !data.isLive(i)) // nije sekcija ili je uklonjena
+      {
+        continue;
+      }
+
+      const std::string& sectionName = symbol.name;
+      auto [sectionIdIter, isInserted] = globalSectionIds.emplace(sectionName, globalSections.size());
+      if(isInserted) // sekcija se prvi put dodaje
+      {
+        globalSections.emplace_back();
+        globalSections.back().name = sectionName;
+        globalSections.back().size = 0;
+      }
+      data.globalSectionIds[i] = sectionIdIter->second;
 
+      GlobalSectionData& sectionData = globalSections[sectionIdIter->second];
+      // adresa sekcije u odnosu na druge istoimene sekcije. Kasnije cemo dodati i pocetnu adresu sekcija
+      symbol.value = sectionData.size;
+      sectionData.size += symbol.size; // povecavanje velicine spojenih istoimenih sekcija
+      const std::vector<uint8_t>& bytes = data.sectionMemoryMap[i];
+      sectionData.inputSections.push_back({bytes.data(), static_cast<uint32_t>(bytes.size())});
+    }
   }
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::printLinkingInfo()
+// -incremental: pamti gde su u izlaznim sekcijama delovi svakog ulaznog objektnog fajla.
+// Ulazni objektni fajlovi su na pocetku objectFilesData, pre clanova arhiva.
+void Linker::recordInputSections()
 {
-  printGlobalSectionData();
-  printGlobalSymbolTable();
+  uint32_t objectIndex = 0;
+  for(LinkStateInput& input : inputStates)
+  {
+    if(input.layoutHash == 0) // arhiva
+    {
+      continue;
+    }
+
+    const LinkerInputData& data = objectFilesData[objectIndex++];
+    for(uint32_t i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      if(data.globalSectionIds[i] != INVALID_NUMBER)
+      {
+        input.sections.push_back({i, data.globalSectionIds[i], static_cast<uint32_t>(data.symbolTable[i].value)});
+      }
+    }
+  }
 }
 //---------------------------------------------------------------------------------------------------------------------
-void Linker::printGlobalSectionData()
+// Proverava preklapanja sekcija sa fiksnim adresama prolaskom kroz intervale sortirane po pocetku.
+void Linker::checkFixedPlacements()
 {
-    std::cout << "===================================\n";
-    std::cout << "Global Section Data:\n";
-    
-    for (const std::string& sectionName : sectionOrder)
+  std::vector<AddressInterval> intervals = getFixedIntervals();
+
+  uint64_t maxEnd = 0;
+  const std::string* maxEndSection = nullptr;
+  for(const AddressInterval& interval : intervals)
+  {
+    if(interval.end > ADDRESS_SPACE_END)
+    {
+      throw LinkerError("Sekcija " + *interval.sectionName + " izlazi van adresnog prostora!");
+    }
+    if(interval.start < MMIO_END && interval.end > MMIO_START)
+    {
+      throw LinkerError("Sekcija " + *interval.sectionName + " se preklapa sa memorijski mapiranim registrima!");
+    }
+    if(maxEndSection != nullptr && interval.start < maxEnd)
     {
-        const GlobalSectionData& sectionData = globalSectionDataMap[sectionName];
-        std::cout << "-----------------------------------\n";
-        std::cout << "Section Name: " << sectionName << "\n";
-        std::cout << "Start Address: 0x" << std::hex << sectionData.startAddress << "\n";
-        std::cout << "Size: " << std::dec << sectionData.size << " bytes\n";
+      throw LinkerError("Nije moguce smestiti sekcije na navedenim adresama, preklapaju se " +
+                        *maxEndSection + " i " + *interval.sectionName + "!");
     }
-    std::cout << "===================================\n";
+    if(interval.end > maxEnd)
+    {
+      maxEnd = interval.end;
+      maxEndSection = interval.sectionName;
+    }
+  }
 }
+//---------------------------------------------------------------------------------------------------------------------
+// Sekcije bez fiksne adrese se smestaju u slobodne rupe oblasti (first-fit ili best-fit) ili iza fiksnih (append).
+void Linker::findSectionsStartAddress()
+{
+  std::vector<uint32_t> sectionRegions(globalSections.size(), DEFAULT_REGION);
+  std::vector<bool> isArranged(globalSections.size(), false);
+  uint64_t firstFreeAddress = 0;
 
-void Linker::printGlobalSymbolTable()
+  for(auto& placement : sectionPlacements)
+  {
+    uint32_t sectionId = globalSectionIds.at(placement.sectionName);
+    if(!placement.regionName.empty())
+    {
+      if(options.fit == PlacementFit::APPEND) // append ne trazi rupe, pa oblasti ne bi bile postovane
+      {
+        throw LinkerError("Sekcija " + placement.sectionName + " se smesta u oblast " + placement.regionName +
+                          ", sto nije moguce uz -fit=append!");
+      }
+      sectionRegions[sectionId] = findRegion(placement.regionName);
+      continue;
+    }
+
+    GlobalSectionData& sectionData = globalSections[sectionId];
+    sectionData.startAddress = placement.startAddress;
+    firstFreeAddress = std::max(firstFreeAddress, static_cast<uint64_t>(sectionData.startAddress) + sectionData.size);
+    isArranged[sectionId] = true;
+
+    *options.log << placement.sectionName << " " << placement.startAddress << "\n";
+  }
+
+  std::vector<uint32_t> placementOrder; // redosled prvog pojavljivanja
+  for(uint32_t i = 0, numSections = globalSections.size(); i < numSections; ++i)
+  {
+    if(!isArranged[i])
+    {
+      placementOrder.push_back(i);
+    }
+  }
+  if(!options.profileFilePath.empty())
+  {
+    orderByProfile(placementOrder, sectionRegions, firstFreeAddress);
+  }
+
+  placeSections(placementOrder, sectionRegions, firstFreeAddress);
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::placeSections(
+  const std::vector<uint32_t>& placementOrder,
+  const std::vector<uint32_t>& sectionRegions,
+  uint64_t firstFreeAddress)
+{
+  if(options.fit == PlacementFit::APPEND)
+  {
+    for(uint32_t i : placementOrder)
+    {
+      GlobalSectionData& sectionData = globalSections[i];
+      uint64_t startAddress = alignUp(firstFreeAddress, options.alignment);
+      if(startAddress + sectionData.size > MMIO_START)
+      {
+        throw LinkerError("Sekcija " + sectionData.name + " ne staje iza sekcija sa fiksnim adresama!");
+      }
+      sectionData.startAddress = startAddress;
+      firstFreeAddress = startAddress + sectionData.size;
+    }
+    return;
+  }
+
+  std::vector<std::vector<AddressInterval>> regionGaps = findFreeGaps();
+  for(uint32_t i : placementOrder)
+  {
+    GlobalSectionData& sectionData = globalSections[i];
+    std::vector<AddressInterval>& gaps = regionGaps[sectionRegions[i]];
+
+    AddressInterval* chosenGap = nullptr;
+    for(AddressInterval& gap : gaps)
+    {
+      uint64_t startAddress = alignUp(gap.start, options.alignment);
+      if(startAddress + sectionData.size > gap.end)
+      {
+        continue;
+      }
+      if(chosenGap == nullptr || (options.fit == PlacementFit::BEST_FIT &&
+                                  gap.end - startAddress - sectionData.size <
+                                  chosenGap->end - alignUp(chosenGap->start, options.alignment) - sectionData.size))
+      {
+        chosenGap = &gap;
+      }
+      if(options.fit == PlacementFit::FIRST_FIT)
+      {
+        break;
+      }
+    }
+
+    if(chosenGap == nullptr)
+    {
+      throw LinkerError("Sekcija " + sectionData.name + " ne staje ni u jednu slobodnu oblast memorije!");
+    }
+
+    sectionData.startAddress = alignUp(chosenGap->start, options.alignment);
+    chosenGap->start = static_cast<uint64_t>(sectionData.startAddress) + sectionData.size;
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+// -profile: izvrsavane sekcije idu prve, po opadajucem broju izvrsenih instrukcija, pa se smestaju jedna do druge
+// u najnize rupe. Neizvrsavane sekcije zadrzavaju redosled i idu na kraj. Ispisuje broj stranica koje dodiruju
+// izvrsavane sekcije sa i bez profila.
+void Linker::orderByProfile(std::vector<uint32_t>& placementOrder, const std::vector<uint32_t>& sectionRegions,
+                            uint64_t firstFreeAddress)
+{
+  std::vector<uint64_t> sectionCounts(globalSections.size(), 0);
+  uint32_t numHotSections = 0;
+  for(const ProfileEntry& entry : ProfileFileProcessor::readFromFile(options.profileFilePath))
+  {
+    auto sectionIdIter = globalSectionIds.find(entry.name); // sekcije kojih vise nema se zanemaruju
+    if(sectionIdIter != globalSectionIds.end() && entry.count != 0)
+    {
+      numHotSections += sectionCounts[sectionIdIter->second] == 0;
+      sectionCounts[sectionIdIter->second] += entry.count;
+    }
+  }
+
+  bool hasDefaultLayout = true;
+  try
+  {
+    placeSections(placementOrder, sectionRegions, firstFreeAddress);
+  }
+  catch(const LinkerError&) // mozda staje tek u redosledu po profilu
+  {
+    hasDefaultLayout = false;
+  }
+  uint64_t defaultPages = hasDefaultLayout ? countTouchedPages(sectionCounts) : 0;
+
+  std::stable_sort(placementOrder.begin(), placementOrder.end(),
+    [&sectionCounts](uint32_t section1, uint32_t section2)
+    {
+      return sectionCounts[section1] > sectionCounts[section2];
+    });
+  placeSections(placementOrder, sectionRegions, firstFreeAddress);
+
+  *options.log << "Profil: izvrsavane sekcije " << std::dec << numHotSections << ", dodirnute stranice "
+            << countTouchedPages(sectionCounts);
+  if(hasDefaultLayout)
+  {
+    *options.log << " (bez profila " << defaultPages << ")";
+  }
+  *options.log << "\n";
+}
+//---------------------------------------------------------------------------------------------------------------------
+uint64_t Linker::countTouchedPages(const std::vector<uint64_t>& sectionCounts) const
+{
+  std::vector<std::pair<uint64_t, uint64_t>> pageRanges; // [prva, poslednja] stranica izvrsavane sekcije
+  for(uint32_t i = 0, numSections = globalSections.size(); i < numSections; ++i)
+  {
+    const GlobalSectionData& sectionData = globalSections[i];
+    if(sectionCounts[i] != 0 && sectionData.size != 0)
+    {
+      pageRanges.emplace_back(sectionData.startAddress / PAGE_SIZE,
+                              (static_cast<uint64_t>(sectionData.startAddress) + sectionData.size - 1) / PAGE_SIZE);
+    }
+  }
+  std::sort(pageRanges.begin(), pageRanges.end());
+
+  uint64_t numPages = 0, nextPage = 0;
+  for(const auto& [firstPage, lastPage] : pageRanges)
+  {
+    uint64_t start = std::max(firstPage, nextPage);
+    if(lastPage >= start)
+    {
+      numPages += lastPage - start + 1;
+      nextPage = lastPage + 1;
+    }
+  }
+
+  return numPages;
+}
+//---------------------------------------------------------------------------------------------------------------------
+// intervali sekcija sa fiksnim adresama, sortirani po pocetnoj adresi (prazne sekcije se preskacu)
+std::vector<AddressInterval> Linker::getFixedIntervals()
+{
+  std::vector<AddressInterval> intervals;
+  intervals.reserve(sectionPlacements.size());
+  for(const SectionPlacement& placement : sectionPlacements)
+  {
+    uint32_t size = getGlobalSection(placement.sectionName).size;
+    if(placement.regionName.empty() && size != 0)
+    {
+      intervals.push_back({placement.startAddress, static_cast<uint64_t>(placement.startAddress) + size,
+                           &placement.sectionName});
+    }
+  }
+
+  std::sort(intervals.begin(), intervals.end(),
+    [](const AddressInterval& interval1, const AddressInterval& interval2)
+    {
+      return interval1.start < interval2.start;
+    });
+
+  return intervals;
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Za svaku oblast vraca slobodne rupe po rastucim adresama: oblast bez fiksnih sekcija i MMIO opsega.
+std::vector<std::vector<AddressInterval>> Linker::findFreeGaps()
+{
+  std::vector<PlacementRegion> regions = options.regions;
+  if(regions.empty())
+  {
+    regions.push_back({"", 0, MMIO_START});
+  }
+
+  std::vector<AddressInterval> occupied = getFixedIntervals();
+  occupied.push_back({MMIO_START, MMIO_END, nullptr}); // MMIO je poslednji, intervali ostaju sortirani
+
+  std::vector<std::vector<AddressInterval>> regionGaps;
+  for(const PlacementRegion& region : regions)
+  {
+    std::vector<AddressInterval>& gaps = regionGaps.emplace_back();
+    uint64_t regionEnd = std::min<uint64_t>(static_cast<uint64_t>(region.startAddress) + region.size, ADDRESS_SPACE_END);
+    uint64_t gapStart = region.startAddress;
+    for(const AddressInterval& interval : occupied)
+    {
+      if(interval.end <= gapStart)
+      {
+        continue;
+      }
+      if(interval.start >= regionEnd)
+      {
+        break;
+      }
+      if(interval.start > gapStart)
+      {
+        gaps.push_back({gapStart, interval.start, nullptr});
+      }
+      gapStart = interval.end;
+    }
+    if(gapStart < regionEnd)
+    {
+      gaps.push_back({gapStart, regionEnd, nullptr});
+    }
+  }
+
+  return regionGaps;
+}
+//---------------------------------------------------------------------------------------------------------------------
+uint32_t Linker::findRegion(const std::string& regionName) const
+{
+  for(uint32_t i = 0, numRegions = options.regions.size(); i < numRegions; ++i)
+  {
+    if(options.regions[i].name == regionName)
+    {
+      return i;
+    }
+  }
+
+  throw LinkerError("Nepostojeca oblast memorije " + regionName);
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Kopira ulazne sekcije jednom, direktno u izlaznu sliku u kojoj su sekcije poredjane po adresi.
+// Posle toga ucitani bajtovi ulaznih fajlova vise nisu potrebni i oslobadjaju se.
+void Linker::buildOutputImage()
+{
+  uint64_t imageSize = 0;
+  for(uint32_t sectionId : sortByAddress(globalSections))
+  {
+    globalSections[sectionId].imageOffset = imageSize;
+    imageSize += globalSections[sectionId].size;
+  }
+  if(imageSize > UINT32_MAX)
+  {
+    throw LinkerError("Ukupna velicina sekcija prelazi adresni prostor!");
+  }
+  outputImage.resize(imageSize);
+
+  for(GlobalSectionData& sectionData : globalSections)
+  {
+    uint8_t* destination = outputImage.data() + sectionData.imageOffset;
+    uint32_t copiedSize = 0;
+    for(const InputSectionView& view : sectionData.inputSections)
+    {
+      if(copiedSize + view.size > sectionData.size)
+      {
+        throw LinkerError("Greska u velicini generisanog koda!");
+      }
+      std::copy(view.bytes, view.bytes + view.size, destination + copiedSize);
+      copiedSize += view.size;
+    }
+    if(copiedSize != sectionData.size)
+    {
+      throw LinkerError("Greska u velicini generisanog koda!");
+    }
+    sectionData.inputSections.clear();
+  }
+
+  for(LinkerInputData& data : objectFilesData)
+  {
+    data.sectionMemoryMap.clear();
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::initGlobalSymbolTable()
+{
+  for(const auto& data : objectFilesData)
+  {
+    for(int i = 0, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      
+      // obradjujemo samo simbole koje izvozimo iz tabele simbola, iz sekcija koje nisu uklonjene
+      if(symbol.sectionNumber == i || symbol.isExtern || !symbol.isGlobal || !data.isLive(symbol.sectionNumber))
+      {
+        continue;
+      }
+
+      if(!globalSymbolIds.emplace(symbol.name, globalSymbols.size()).second)
+      {
+        throw LinkerError("Redeklaracija simbola " + symbol.name);
+      }
+
+      const Symbol& section = data.symbolTable[symbol.sectionNumber];
+      const auto& globalSectionData = globalSections[data.globalSectionIds[symbol.sectionNumber]];
+
+      // pocetna adresa segmenta sekcija + pocetak dela te sekcije za ovaj fajl 
+      uint32_t sectionOffset = globalSectionData.startAddress + section.value;
+      globalSymbols.push_back({symbol.name, symbol.value + sectionOffset});
+    }  
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Jednom po simbolu povezuje lokalne indekse simbola koji se koriste u relokacijama sa globalnim simbolima,
+// tako da se pri prepravljanju relokacija ne pretrazuju stringovi. Prijavljuje sve nedefinisane simbole odjednom.
+void Linker::resolveSymbols()
+{
+  std::vector<std::string> undefinedSymbols;
+  std::unordered_set<std::string> reportedSymbols;
+
+  for(auto& data : objectFilesData)
+  {
+    data.globalSymbolIds.assign(data.symbolTable.size(), INVALID_NUMBER);
+    std::vector<bool> isVisited(data.symbolTable.size(), false);
+
+    for(const auto& [sectionUsageNumber, relocationEntries] : data.sectionRelocationMap)
+    {
+      if(!data.isLive(sectionUsageNumber))
+      {
+        continue;
+      }
+      for(const RelocationEntry& entry : relocationEntries)
+      {
+        uint32_t reference = entry.symbolTableReference;
+        if(isVisited[reference] || data.globalSectionIds[reference] != INVALID_NUMBER) // vec razresen ili sekcija
+        {
+          continue;
+        }
+        isVisited[reference] = true;
+
+        const std::string& symbolName = data.symbolTable[reference].name;
+        auto symbolIdIter = globalSymbolIds.find(symbolName);
+        if(symbolIdIter != globalSymbolIds.end())
+        {
+          data.globalSymbolIds[reference] = symbolIdIter->second;
+        }
+        else if(reportedSymbols.insert(symbolName).second)
+        {
+          undefinedSymbols.push_back(symbolName);
+        }
+      }
+    }
+  }
+
+  if(!undefinedSymbols.empty())
+  {
+    std::string message = "Upotrebljeni nepostojeci simboli:";
+    for(const std::string& symbolName : undefinedSymbols)
+    {
+      message += " " + symbolName;
+    }
+    throw LinkerError(message);
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Ulazne sekcije zauzimaju disjunktne delove izlaznih sekcija, pa se relokacije svake ulazne sekcije
+// prepravljaju nezavisno. Rezultat ne zavisi od broja niti.
+void Linker::patchRelocationEntries()
+{
+  struct RelocationSlice
+  {
+    const LinkerInputData* data;
+    uint32_t sectionUsageNumber;
+    const std::vector<RelocationEntry>* relocationEntries;
+  };
+
+  std::vector<RelocationSlice> slices;
+  uint64_t numRelocations = 0;
+  for(const auto& data : objectFilesData)
+  {
+    for(const auto& [sectionUsageNumber, relocationEntries] : data.sectionRelocationMap)
+    {
+      if(!data.isLive(sectionUsageNumber))
+      {
+        continue;
+      }
+      slices.push_back({&data, sectionUsageNumber, &relocationEntries});
+      numRelocations += relocationEntries.size();
+    }
+  }
+
+  uint32_t numThreads = options.numThreads != 0 ? options.numThreads : std::thread::hardware_concurrency();
+  if(numThreads <= 1 || numRelocations < MIN_PARALLEL_RELOCATIONS)
+  {
+    for(const RelocationSlice& slice : slices)
+    {
+      patchRelocationSlice(*slice.data, slice.sectionUsageNumber, *slice.relocationEntries);
+    }
+    return;
+  }
+
+  // veci delovi prvi, da se niti ravnomernije opterete
+  std::sort(slices.begin(), slices.end(),
+    [](const RelocationSlice& slice1, const RelocationSlice& slice2)
+    {
+      return slice1.relocationEntries->size() > slice2.relocationEntries->size();
+    });
+
+  ThreadPool threadPool(numThreads);
+  threadPool.parallelFor(slices.size(), [this, &slices](uint32_t i)
+    {
+      patchRelocationSlice(*slices[i].data, slices[i].sectionUsageNumber, *slices[i].relocationEntries);
+    });
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::patchRelocationSlice(
+  const LinkerInputData& data,
+  uint32_t sectionUsageNumber,
+  const std::vector<RelocationEntry>& relocationEntries)
+{
+  // mem[sectionUsageStartAddr + offset] = symbolValue
+  auto& globalSectionData = globalSections[data.globalSectionIds[sectionUsageNumber]];
+  // memorija je samo za trenutne sekcije sa ovim imenom pa uzimamo offset za sekciju u ovom fajlu + offset do koriscenja
+  uint32_t sectionUsageOffset = data.symbolTable[sectionUsageNumber].value;
+
+  std::vector<SectionMemory::WordPatch> patches;
+  patches.reserve(relocationEntries.size());
+  for(const RelocationEntry& entry : relocationEntries)
+  {
+    // oc za trenutni skup instrukcija nije bitan (sve upisujemo na 4B)
+    uint32_t reference = entry.symbolTableReference;
+
+    uint32_t symbolValue;
+    uint32_t sectionId = data.globalSectionIds[reference];
+    if(sectionId != INVALID_NUMBER) // sekcija
+    {
+      symbolValue = globalSections[sectionId].startAddress + data.symbolTable[reference].value;
+    }
+    else // globalni simbol, razresen u resolveSymbols
+    {
+      symbolValue = globalSymbols[data.globalSymbolIds[reference]].value;
+    }
+
+    patches.push_back({sectionUsageOffset + entry.offset, symbolValue});
+  }
+
+  // asembler upisuje relokacije sortirane po offsetu, ostali ulazi se sortiraju ovde
+  auto byAddress = [](const SectionMemory::WordPatch& patch1, const SectionMemory::WordPatch& patch2)
+  {
+    return patch1.address < patch2.address;
+  };
+  if(!std::is_sorted(patches.begin(), patches.end(), byAddress))
+  {
+    std::sort(patches.begin(), patches.end(), byAddress);
+  }
+  SectionMemory::addToWords(outputImage.data() + globalSectionData.imageOffset, globalSectionData.size,
+                            patches.data(), patches.data() + patches.size());
+}
+//---------------------------------------------------------------------------------------------------------------------
+// sekcija navedena u -place opciji mora postojati u nekom ulaznom fajlu
+GlobalSectionData& Linker::getGlobalSection(const std::string& sectionName)
+{
+  auto sectionIdIter = globalSectionIds.find(sectionName);
+  if(sectionIdIter == globalSectionIds.end())
+  {
+    throw LinkerError("Nepostojeca sekcija " + sectionName);
+  }
+  return globalSections[sectionIdIter->second];
+}
+//---------------------------------------------------------------------------------------------------------------------
+std::vector<OutputSegment> Linker::getOutputSegments() const
+{
+  std::vector<OutputSegment> segments;
+  for(uint32_t sectionId : sortByAddress(globalSections))
+  {
+    const GlobalSectionData& sectionData = globalSections[sectionId];
+    segments.push_back({sectionData.startAddress, outputImage.data() + sectionData.imageOffset, sectionData.size});
+  }
+  return segments;
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::writeOutputFiles()
+{
+  if(!outputFilePath.empty())
+  {
+    ExecutableFileProcessor::writeToFile(getOutputSegments(), outputFilePath);
+  }
+  if(!options.mapFilePath.empty())
+  {
+    writeMapFile();
+  }
+  if(options.incremental)
+  {
+    writeLinkState();
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Tabela simbola izlaza: UND, spojene sekcije, definisani simboli svih fajlova (lokalni ostaju, vrednost im je
+// relativna u odnosu na spojenu sekciju) i po jedan ulaz za svaki simbol koji nijedan ulaz ne definise.
+// Relokacije na sekcije se preusmeravaju na spojene sekcije, a pocetak dela sekcije iz fajla se dodaje reci
+// na mestu relokacije, isto kao sto asembler upisuje offset u sekciji. Relokacije na simbole ostaju simbolicke.
+void Linker::writeRelocatableObject()
+{
+  AssemblerOutputData output;
+  output.symbolTable.emplace_back("UND", 0, -1, false, false, false, 0);
+  for(const GlobalSectionData& sectionData : globalSections)
+  {
+    uint32_t sectionNumber = output.symbolTable.size();
+    output.symbolTable.emplace_back(sectionData.name, sectionNumber, 0, false, false, false, sectionData.size);
+    output.sectionOrder.push_back(sectionData.name);
+    output.sectionMemoryMap[sectionNumber];
+  }
+  auto toSectionNumber = [](uint32_t sectionId) { return sectionId + 1; };
+
+  // indeksi u izlaznoj tabeli simbola, po fajlu
+  std::vector<std::vector<uint32_t>> symbolIds(objectFilesData.size());
+  std::unordered_map<std::string, uint32_t> definedGlobals;
+  for(uint32_t k = 0, numFiles = objectFilesData.size(); k < numFiles; ++k)
+  {
+    const LinkerInputData& data = objectFilesData[k];
+    symbolIds[k].assign(data.symbolTable.size(), INVALID_NUMBER);
+    for(uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      if(symbol.sectionNumber == i)
+      {
+        symbolIds[k][i] = toSectionNumber(data.globalSectionIds[i]);
+        continue;
+      }
+      if(symbol.isExtern)
+      {
+        continue;
+      }
+
+      uint32_t symbolId = output.symbolTable.size();
+      if(symbol.isGlobal && !definedGlobals.emplace(symbol.name, symbolId).second)
+      {
+        throw LinkerError("Redeklaracija simbola " + symbol.name);
+      }
+      output.symbolTable.push_back(symbol);
+      output.symbolTable.back().symbolUsages.clear();
+      if(symbol.sectionNumber != INVALID_SECTION) // apsolutni simboli ostaju nepromenjeni
+      {
+        output.symbolTable.back().sectionNumber = toSectionNumber(data.globalSectionIds[symbol.sectionNumber]);
+        output.symbolTable.back().value += data.symbolTable[symbol.sectionNumber].value;
+      }
+      symbolIds[k][i] = symbolId;
+    }
+  }
+
+  std::unordered_map<std::string, uint32_t> undefinedSymbols;
+  for(uint32_t k = 0, numFiles = objectFilesData.size(); k < numFiles; ++k)
+  {
+    const LinkerInputData& data = objectFilesData[k];
+    for(uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      const Symbol& symbol = data.symbolTable[i];
+      if(symbol.sectionNumber == i || !symbol.isExtern)
+      {
+        continue;
+      }
+
+      auto definitionIter = definedGlobals.find(symbol.name);
+      if(definitionIter != definedGlobals.end())
+      {
+        symbolIds[k][i] = definitionIter->second;
+        continue;
+      }
+
+      auto [undefinedIter, isInserted] = undefinedSymbols.emplace(symbol.name, output.symbolTable.size());
+      if(isInserted)
+      {
+        output.symbolTable.push_back(symbol);
+        output.symbolTable.back().symbolUsages.clear();
+      }
+      symbolIds[k][i] = undefinedIter->second;
+    }
+  }
+
+  // delovi sekcija se dodaju istim redosledom kojim su im dodeljeni offseti u processProgramSections
+  for(uint32_t k = 0, numFiles = objectFilesData.size(); k < numFiles; ++k)
+  {
+    LinkerInputData& data = objectFilesData[k];
+    for(uint32_t i = 1, tableSize = data.symbolTable.size(); i < tableSize; ++i)
+    {
+      if(data.symbolTable[i].sectionNumber != i)
+      {
+        continue;
+      }
+
+      uint32_t sectionNumber = toSectionNumber(data.globalSectionIds[i]);
+      uint32_t sectionPartOffset = data.symbolTable[i].value;
+      SectionMemory& memory = output.sectionMemoryMap[sectionNumber];
+      if(memory.getSectionSize() != sectionPartOffset)
+      {
+        throw LinkerError("Greska u velicini generisanog koda!");
+      }
+      memory.writeBytes(data.sectionMemoryMap[i]);
+
+      auto relocationsIter = data.sectionRelocationMap.find(i);
+      if(relocationsIter == data.sectionRelocationMap.end())
+      {
+        continue;
+      }
+      std::vector<RelocationEntry>& relocations = output.sectionRelocationMap[sectionNumber];
+      for(const RelocationEntry& entry : relocationsIter->second)
+      {
+        uint32_t reference = entry.symbolTableReference;
+        if(data.globalSectionIds[reference] != INVALID_NUMBER) // sekcija
+        {
+          memory.addToAddress(sectionPartOffset + entry.offset, data.symbolTable[reference].value);
+        }
+        if(symbolIds[k][reference] == INVALID_NUMBER)
+        {
+          throw LinkerError("Nevazeca relokacija na simbol " + data.symbolTable[reference].name);
+        }
+        relocations.emplace_back(entry.operationCode, sectionPartOffset + entry.offset, symbolIds[k][reference]);
+      }
+    }
+  }
+
+  ObjectFileProcessor::writeToFile(output, outputFilePath);
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::writeMapFile()
+{
+  MapFileData mapData;
+  for(const GlobalSectionData& sectionData : globalSections)
+  {
+    mapData.sections.push_back({sectionData.name, sectionData.startAddress, sectionData.size});
+  }
+
+  for(const GlobalSymbol& symbol : globalSymbols)
+  {
+    mapData.symbols.push_back({symbol.name, symbol.value, 0});
+  }
+  std::sort(mapData.symbols.begin(), mapData.symbols.end(),
+    [](const MapEntry& symbol1, const MapEntry& symbol2)
+    {
+      return symbol1.address < symbol2.address;
+    });
+
+  MapFileProcessor::writeToFile(mapData, options.mapFilePath);
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::writeLinkState()
+{
+  LinkState state;
+  state.optionsHash = getOptionsHash();
+  for(const GlobalSectionData& sectionData : globalSections)
+  {
+    state.sections.push_back({sectionData.name, sectionData.startAddress, sectionData.size, sectionData.imageOffset});
+  }
+  for(const GlobalSymbol& symbol : globalSymbols)
+  {
+    state.symbols.push_back({symbol.name, symbol.value});
+  }
+
+  state.inputs = inputStates;
+  state.image = outputImage;
+
+  LinkStateFileProcessor::writeToFile(state, getLinkStatePath());
+}
+//---------------------------------------------------------------------------------------------------------------------
+// opcije od kojih zavisi raspored sekcija, zajedno sa spiskom ulaznih fajlova
+uint64_t Linker::getOptionsHash() const
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for(const std::string& inputFilePath : inputFilePaths)
+  {
+    hash = fnv1a(inputFilePath, hash);
+  }
+  for(const SectionPlacement& placement : sectionPlacements)
+  {
+    hash = fnv1a(placement.sectionName, hash);
+    hash = fnv1a(placement.startAddress, hash);
+    hash = fnv1a(placement.regionName, hash);
+  }
+  for(const PlacementRegion& region : options.regions)
+  {
+    hash = fnv1a(region.name, hash);
+    hash = fnv1a(region.startAddress, hash);
+    hash = fnv1a(region.size, hash);
+  }
+  hash = fnv1a(options.alignment, hash);
+  hash = fnv1a(static_cast<uint64_t>(options.fit), hash);
+  hash = fnv1a(options.gcSections, hash);
+  for(const std::string& root : options.gcRoots)
+  {
+    hash = fnv1a(root, hash);
+  }
+  if(!options.profileFilePath.empty()) // profil menja raspored sekcija
+  {
+    hash = fnv1a(readFile(options.profileFilePath), hash);
+  }
+
+  return hash;
+}
+//---------------------------------------------------------------------------------------------------------------------
+// Sve sto utice na raspored sekcija i globalne simbole: tabela simbola, a za -gc-sections i skup simbola
+// koje koristi svaka sekcija (od njega zavisi koje sekcije ostaju).
+uint64_t Linker::getLayoutHash(const LinkerInputData& data) const
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for(const Symbol& symbol : data.symbolTable)
+  {
+    hash = fnv1a(symbol.name, hash);
+    hash = fnv1a(symbol.sectionNumber, hash);
+    hash = fnv1a(static_cast<uint32_t>(symbol.value), hash);
+    hash = fnv1a(symbol.size, hash);
+    hash = fnv1a(symbol.isGlobal | symbol.isExtern << 1 | symbol.isDefined << 2, hash);
+  }
+
+  if(options.gcSections)
+  {
+    std::map<uint32_t, std::set<uint32_t>> sectionReferences; // sortirano, ne zavisi od redosleda u mapi
+    for(const auto& [sectionNumber, relocationEntries] : data.sectionRelocationMap)
+    {
+      std::set<uint32_t>& references = sectionReferences[sectionNumber];
+      for(const RelocationEntry& entry : relocationEntries)
+      {
+        references.insert(entry.symbolTableReference);
+      }
+    }
+    for(const auto& [sectionNumber, references] : sectionReferences)
+    {
+      hash = fnv1a(sectionNumber, hash);
+      for(uint32_t reference : references)
+      {
+        hash = fnv1a(reference, hash);
+      }
+    }
+  }
+
+  return hash != 0 ? hash : 1; // 0 oznacava arhivu
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::printLinkingInfo()
+{
+  printGlobalSectionData();
+  printGlobalSymbolTable();
+  if(options.printTimings)
+  {
+    printPhaseTimes();
+  }
+}
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::printGlobalSectionData()
+{
+    *options.log << "===================================\n";
+    *options.log << "Global Section Data:\n";
+    
+    for (const GlobalSectionData& sectionData : globalSections)
+    {
+        *options.log << "-----------------------------------\n";
+        *options.log << "Section Name: " << sectionData.name << "\n";
+        *options.log << "Start Address: 0x" << std::hex << sectionData.startAddress << "\n";
+        *options.log << "Size: " << std::dec << sectionData.size << " bytes\n";
+    }
+    *options.log << "===================================\n";
+}
+
+void Linker::printGlobalSymbolTable()
+{
+  *options.log << "Global Symbol Table:\n";
+  *options.log << "-----------------------------------\n";
+  *options.log << "Name,Value\n";
+  for(const GlobalSymbol& symbol : globalSymbols)
+  {
+    *options.log << symbol.name << ", 0x" << std::hex << symbol.value << "\n";
+  }
+  *options.log << "===================================\n";
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void Linker::printPhaseTimes()
 {
-  std::cout << "Global Symbol Table:\n";
-  std::cout << "-----------------------------------\n";
-  std::cout << "Name,Value\n";
-  for(const auto& [symbolName, value] : globalSymbolTable)
+  *options.log << "Phase Times:\n";
+  *options.log << "-----------------------------------\n";
+  for(const PhaseTime& phaseTime : phaseTimes)
   {
-    std::cout << symbolName << ", 0x" << std::hex << value << "\n";
+    *options.log << phaseTime.name << ": " << std::dec << phaseTime.microseconds << " us\n";
   }
-  std::cout << "===================================\n";
+  *options.log << "===================================\n";
 }
 
 } // namespace lnk_core
\ No newline at end of file
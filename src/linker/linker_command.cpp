@@ -0,0 +1,175 @@
+#include <linker/linker_command.hpp>
+
+#include <common/exceptions.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+using namespace common;
+
+namespace lnk_core
+{
+
+LinkerCommand parseLinkerCommand(const std::vector<std::string>& arguments)
+{
+  LinkerCommand command;
+  std::vector<SectionPlacement>& placements = command.placements;
+  std::vector<std::string>& inputFilePaths = command.inputFilePaths;
+  std::string& outputFilePath = command.outputFilePath;
+  LinkerOptions& options = command.options;
+  bool hexFlag = false;
+  size_t i = 0;
+  while(i < arguments.size())
+  {
+    const std::string& argument = arguments[i];
+
+    if(argument == "-o")
+    {
+      if(outputFilePath.empty() && i + 1 < arguments.size())
+      {
+        outputFilePath = arguments[++i];
+      }
+      else
+      {
+        throw RuntimeError("Greska u -o opciji");
+      }
+    }
+    else if(argument.find("-place=") == 0)
+    {
+      std::string placement = argument.substr(7);
+      size_t separatorPos = placement.find('@');
+      if(separatorPos != std::string::npos)
+      {
+        std::string sectionName = placement.substr(0, separatorPos);
+        std::string addressStr = placement.substr(separatorPos + 1);
+        if(!addressStr.empty() && isdigit(addressStr[0])) // adresa
+        {
+          uint32_t startAddress = strtoul(addressStr.c_str(), nullptr, 0);
+          placements.push_back({sectionName, startAddress, ""});
+        }
+        else // ime oblasti iz -region opcije
+        {
+          placements.push_back({sectionName, 0, addressStr});
+        }
+      }
+      else
+      {
+        throw RuntimeError("Greska u -place opciji!");
+      }
+    }
+    else if(argument.find("-region=") == 0)
+    {
+      // -region=ime@pocetak:velicina
+      std::string region = argument.substr(8);
+      size_t separatorPos = region.find('@');
+      size_t sizePos = region.find(':', separatorPos);
+      if(separatorPos == std::string::npos || sizePos == std::string::npos)
+      {
+        throw RuntimeError("Greska u -region opciji!");
+      }
+      uint32_t startAddress = strtoul(region.substr(separatorPos + 1, sizePos - separatorPos - 1).c_str(), nullptr, 0);
+      uint64_t size = strtoull(region.substr(sizePos + 1).c_str(), nullptr, 0);
+      options.regions.push_back({region.substr(0, separatorPos), startAddress, size});
+    }
+    else if(argument.find("-align=") == 0)
+    {
+      options.alignment = strtoul(argument.substr(7).c_str(), nullptr, 0);
+      if(options.alignment == 0 || (options.alignment & (options.alignment - 1)) != 0)
+      {
+        throw RuntimeError("Poravnanje mora biti stepen dvojke!");
+      }
+    }
+    else if(argument.find("-fit=") == 0)
+    {
+      std::string fit = argument.substr(5);
+      if(fit == "first")
+      {
+        options.fit = PlacementFit::FIRST_FIT;
+      }
+      else if(fit == "best")
+      {
+        options.fit = PlacementFit::BEST_FIT;
+      }
+      else if(fit == "append")
+      {
+        options.fit = PlacementFit::APPEND;
+      }
+      else
+      {
+        throw RuntimeError("Greska u -fit opciji, ocekivano first, best ili append!");
+      }
+    }
+    else if(argument == "-gc-sections")
+    {
+      options.gcSections = true;
+    }
+    else if(argument.find("-root=") == 0)
+    {
+      options.gcRoots.push_back(argument.substr(6));
+    }
+    else if(argument.find("-profile=") == 0)
+    {
+      options.profileFilePath = argument.substr(9);
+    }
+    else if(argument.find("-map=") == 0)
+    {
+      options.mapFilePath = argument.substr(5);
+    }
+    else if(argument.find("-threads=") == 0)
+    {
+      options.numThreads = strtoul(argument.substr(9).c_str(), nullptr, 0);
+    }
+    else if(argument == "-timing")
+    {
+      options.printTimings = true;
+    }
+    else if(argument == "-incremental")
+    {
+      options.incremental = true;
+    }
+    else if(argument == "-hex")
+    {
+      hexFlag = true;
+    }
+    else if(argument == "-relocatable")
+    {
+      options.relocatable = true;
+    }
+    else
+    {
+      inputFilePaths.emplace_back(argument);
+    }
+
+    ++i;
+  }
+
+  if(hexFlag == options.relocatable || inputFilePaths.empty() || outputFilePath.empty())
+  {
+    throw RuntimeError("Neka od obaveznih opcija nije navedena (tacno jedna od -hex i -relocatable)!");
+  }
+  if(options.relocatable && (!placements.empty() || !options.regions.empty() || !options.profileFilePath.empty() ||
+                             options.gcSections || options.incremental || !options.mapFilePath.empty()))
+  {
+    throw RuntimeError("Uz -relocatable se ne navode opcije smestanja, -profile, -gc-sections, -incremental ni -map!");
+  }
+
+  // rupe se traze po oblasti, pa bi dve oblasti koje se preklapaju mogle da dobiju sekcije na istim adresama
+  std::vector<PlacementRegion> regions = options.regions;
+  std::sort(regions.begin(), regions.end(),
+    [](const PlacementRegion& region1, const PlacementRegion& region2)
+    {
+      return region1.startAddress < region2.startAddress;
+    });
+  for(size_t j = 1; j < regions.size(); ++j)
+  {
+    if(static_cast<uint64_t>(regions[j - 1].startAddress) + regions[j - 1].size > regions[j].startAddress)
+    {
+      throw RuntimeError("Oblasti memorije " + regions[j - 1].name + " i " + regions[j].name + " se preklapaju!");
+    }
+  }
+
+  return command;
+}
+
+} // namespace lnk_core
@@ -0,0 +1,203 @@
+#include <assembler/assembler_driver.hpp>
+#include <emulator/emulator.hpp>
+#include <linker/linker.hpp>
+
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+#include <common/thread_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace common;
+
+namespace
+{
+
+const std::string USAGE =
+  "Greska! Ispravna sintaksa: ./toolchain [-place=sekcija@adresa ...] [-o izlaz.hex] [-save-temps] [-norun] "
+  "[-stats] [-timing] [-threads=n] ulaz1.s|ulaz1.o [ulaz2.s|ulaz2.o ...]";
+
+struct ToolchainOptions
+{
+  std::vector<lnk_core::SectionPlacement> placements;
+  std::vector<std::string> inputFilePaths;
+  std::string outputFilePath; // izvrsni fajl se upisuje samo ako je naveden
+  bool saveTemps = false; // objektni fajlovi (i tabele asemblera) pored izvornih fajlova
+  bool run = true;
+  bool printTimings = false;
+  uint32_t numThreads = 0;
+  emulator_core::EmulatorOptions emulatorOptions;
+};
+
+bool startsWith(const std::string& argument, const std::string& prefix)
+{
+  return argument.compare(0, prefix.size(), prefix) == 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+bool endsWith(const std::string& argument, const std::string& suffix)
+{
+  return argument.size() >= suffix.size() && argument.compare(argument.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+ToolchainOptions parseArguments(int argc, char* argv[])
+{
+  ToolchainOptions options;
+  for(int i = 1; i < argc; ++i)
+  {
+    std::string argument = argv[i];
+    if(startsWith(argument, "-place="))
+    {
+      std::string placement = argument.substr(7);
+      size_t separatorPos = placement.find('@');
+      if(separatorPos == std::string::npos)
+      {
+        throw RuntimeError("Greska u -place opciji!");
+      }
+      uint32_t startAddress = std::strtoul(placement.substr(separatorPos + 1).c_str(), nullptr, 0);
+      options.placements.push_back({placement.substr(0, separatorPos), startAddress, ""});
+    }
+    else if(argument == "-o" && i + 1 < argc && options.outputFilePath.empty())
+    {
+      options.outputFilePath = argv[++i];
+    }
+    else if(argument == "-save-temps")
+    {
+      options.saveTemps = true;
+    }
+    else if(argument == "-norun")
+    {
+      options.run = false;
+    }
+    else if(argument == "-stats")
+    {
+      options.emulatorOptions.printStatistics = true;
+    }
+    else if(argument == "-timing")
+    {
+      options.printTimings = true;
+    }
+    else if(startsWith(argument, "-threads="))
+    {
+      options.numThreads = std::strtoul(argument.substr(9).c_str(), nullptr, 0);
+    }
+    else if(endsWith(argument, ".s") || endsWith(argument, ".o"))
+    {
+      options.inputFilePaths.push_back(argument);
+    }
+    else
+    {
+      throw RuntimeError(USAGE);
+    }
+  }
+
+  if(options.inputFilePaths.empty())
+  {
+    throw RuntimeError(USAGE);
+  }
+  return options;
+}
+//-----------------------------------------------------------------------------------------------------------
+// izvorni fajlovi se asembliraju istovremeno, direktno u ulaz linkera. Objektni fajlovi se samo citaju
+std::vector<lnk_core::LinkerInputData> assembleInputs(const ToolchainOptions& options)
+{
+  const std::vector<std::string>& inputFilePaths = options.inputFilePaths;
+  std::vector<lnk_core::LinkerInputData> inputData(inputFilePaths.size());
+  std::vector<std::string> errors(inputFilePaths.size());
+
+  uint32_t numThreads = options.numThreads == 0 ? std::thread::hardware_concurrency() : options.numThreads;
+  ThreadPool threadPool(std::max<uint32_t>(1, std::min<uint32_t>(numThreads, inputFilePaths.size())));
+  threadPool.parallelFor(inputFilePaths.size(), [&](uint32_t i)
+    {
+      const std::string& inputFilePath = inputFilePaths[i];
+      try
+      {
+        if(endsWith(inputFilePath, ".o"))
+        {
+          inputData[i] = ObjectFileProcessor::readFromFile(inputFilePath);
+          return;
+        }
+        std::string objectFilePath = options.saveTemps ? inputFilePath.substr(0, inputFilePath.size() - 2) + ".o" : "";
+        inputData[i] = asm_core::assembleToLinkerInput(inputFilePath, objectFilePath);
+      }
+      catch(const std::exception& e)
+      {
+        errors[i] = inputFilePath + ": " + e.what();
+      }
+    });
+
+  std::string errorMessage;
+  for(const std::string& error : errors)
+  {
+    if(!error.empty())
+    {
+      errorMessage += (errorMessage.empty() ? "" : "\n") + error;
+    }
+  }
+  if(!errorMessage.empty())
+  {
+    throw RuntimeError(errorMessage);
+  }
+
+  return inputData;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point& start)
+{
+  auto now = std::chrono::steady_clock::now();
+  uint64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+  start = now;
+  return microseconds;
+}
+
+} // namespace
+
+// asembler, linker i emulator u jednom procesu: izlaz svake faze se predaje sledecoj u memoriji,
+// bez upisa i ponovnog parsiranja objektnih i izvrsnih fajlova
+int main(int argc, char* argv[])
+{
+  try
+  {
+    ToolchainOptions options = parseArguments(argc, argv);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<lnk_core::LinkerInputData> inputData = assembleInputs(options);
+    uint64_t assemblyTime = elapsedMicroseconds(start);
+
+    lnk_core::Linker linker(options.placements, std::move(inputData), options.inputFilePaths, options.outputFilePath);
+    linker.performLinking();
+
+    emulator_core::CodeSegments codeSegments;
+    for(const OutputSegment& segment : linker.getOutputSegments())
+    {
+      codeSegments.emplace_back(segment.startAddress);
+      codeSegments.back().code.assign(segment.bytes, segment.bytes + segment.size);
+    }
+    uint64_t linkingTime = elapsedMicroseconds(start);
+
+    uint64_t emulationTime = 0;
+    if(options.run)
+    {
+      emulator_core::Emulator emulator(std::move(codeSegments), options.emulatorOptions);
+      emulator.emulate();
+      emulationTime = elapsedMicroseconds(start);
+    }
+
+    if(options.printTimings)
+    {
+      std::cout << std::dec << "Asembliranje: " << assemblyTime << " us, linkovanje: " << linkingTime
+                << " us, emulacija: " << emulationTime << " us\n";
+    }
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return -1;
+  }
+}
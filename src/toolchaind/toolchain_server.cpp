@@ -0,0 +1,343 @@
+#include <toolchaind/toolchain_server.hpp>
+
+#include <assembler/assembler_driver.hpp>
+#include <assembler/assembly_cache.hpp>
+#include <linker/linker.hpp>
+#include <linker/linker_command.hpp>
+
+#include <common/archive_file_processor.hpp>
+#include <common/exceptions.hpp>
+#include <common/object_file_processor.hpp>
+#include <common/thread_pool.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <sstream>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace common;
+
+namespace
+{
+constexpr size_t MAX_CACHED_OBJECTS = 4096; // preko ovoga se kes prazni, da server ne raste bez granice
+
+// zatvara vezu i kada obrada baci izuzetak
+class ConnectionGuard
+{
+public:
+  explicit ConnectionGuard(int connectionFd) : connectionFd(connectionFd) {}
+  ~ConnectionGuard() { close(connectionFd); }
+
+  ConnectionGuard(const ConnectionGuard&) = delete;
+  ConnectionGuard& operator=(const ConnectionGuard&) = delete;
+private:
+  int connectionFd;
+};
+
+} // namespace
+
+namespace toolchaind_core
+{
+
+std::shared_ptr<const lnk_core::LinkerInputData> ObjectCache::find(const std::string& filePath)
+{
+  FileStamp stamp;
+  if(!getFileStamp(filePath, stamp))
+  {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto entryIter = entries.find(filePath);
+  if(entryIter == entries.end() || !(entryIter->second.stamp == stamp))
+  {
+    return nullptr;
+  }
+  ++numHits;
+  return entryIter->second.data;
+}
+//-----------------------------------------------------------------------------------------------------------
+void ObjectCache::store(
+  const std::string& filePath,
+  const FileStamp& stamp,
+  std::shared_ptr<const lnk_core::LinkerInputData> data)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if(entries.size() >= MAX_CACHED_OBJECTS && entries.find(filePath) == entries.end())
+  {
+    entries.clear();
+  }
+  entries[filePath] = {stamp, std::move(data)};
+}
+//-----------------------------------------------------------------------------------------------------------
+bool ObjectCache::getFileStamp(const std::string& filePath, FileStamp& stamp)
+{
+  std::error_code errorCode;
+  stamp.size = std::filesystem::file_size(filePath, errorCode);
+  if(errorCode)
+  {
+    return false;
+  }
+  stamp.writeTime = std::filesystem::last_write_time(filePath, errorCode);
+  return !errorCode;
+}
+//-----------------------------------------------------------------------------------------------------------
+ToolchainServer::ToolchainServer(const std::string& socketPath, uint32_t numWorkers)
+  : socketPath(socketPath), numWorkers(std::max<uint32_t>(1, numWorkers))
+{
+  listenFd = listenOnSocket(socketPath);
+}
+//-----------------------------------------------------------------------------------------------------------
+ToolchainServer::~ToolchainServer()
+{
+  stop();
+  for(std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  close(listenFd);
+  unlink(socketPath.c_str());
+}
+//-----------------------------------------------------------------------------------------------------------
+void ToolchainServer::serve()
+{
+  for(uint32_t i = 0; i < numWorkers; ++i)
+  {
+    workers.emplace_back(&ToolchainServer::workerLoop, this);
+  }
+
+  while(!isStopping)
+  {
+    int connectionFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if(connectionFd < 0)
+    {
+      if(isStopping || errno == EINTR || errno == ECONNABORTED)
+      {
+        continue;
+      }
+      stop();
+      throw RuntimeError("Greska pri prihvatanju veze na socket-u " + socketPath + "!");
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    pendingConnections.push(connectionFd);
+    queueCondition.notify_one();
+  }
+
+  for(std::thread& worker : workers)
+  {
+    worker.join();
+  }
+  workers.clear();
+}
+//-----------------------------------------------------------------------------------------------------------
+// radna nit obradjuje jednu po jednu vezu; posle zahteva za gasenje prazni red pa se zavrsava
+void ToolchainServer::workerLoop()
+{
+  while(true)
+  {
+    int connectionFd;
+    {
+      std::unique_lock<std::mutex> lock(queueMutex);
+      queueCondition.wait(lock, [this]() { return isStopping || !pendingConnections.empty(); });
+      if(pendingConnections.empty())
+      {
+        return;
+      }
+      connectionFd = pendingConnections.front();
+      pendingConnections.pop();
+    }
+    handleConnection(connectionFd);
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void ToolchainServer::handleConnection(int connectionFd)
+{
+  ConnectionGuard guard(connectionFd);
+  try
+  {
+    std::vector<std::string> request;
+    if(!readRequest(connectionFd, request))
+    {
+      return;
+    }
+    writeResult(connectionFd, runJob(request));
+    if(request[0] == STOP_REQUEST)
+    {
+      stop();
+    }
+  }
+  catch(const std::exception&) // klijent je prekinuo vezu ili poslao neispravan zahtev, ostali poslovi se nastavljaju
+  {}
+}
+//-----------------------------------------------------------------------------------------------------------
+JobResult ToolchainServer::runJob(const std::vector<std::string>& request)
+{
+  JobResult result;
+  std::ostringstream out;
+  std::ostringstream err;
+  std::vector<std::string> arguments(request.begin() + 1, request.end());
+  try
+  {
+    if(request[0] == ASSEMBLER_REQUEST)
+    {
+      ++numJobs;
+      result.exitCode = runAssembler(arguments, out, err);
+    }
+    else if(request[0] == LINKER_REQUEST)
+    {
+      ++numJobs;
+      result.exitCode = runLinker(arguments, out);
+    }
+    else if(request[0] == STOP_REQUEST)
+    {
+      out << "Server na " << socketPath << " se gasi, poslova: " << numJobs << ", objekata iz kesa: "
+          << objectCache.getNumHits() << "\n";
+    }
+    else
+    {
+      throw RuntimeError("Nepoznat zahtev " + request[0] + "!");
+    }
+  }
+  catch(const std::exception& e)
+  {
+    err << e.what() << '\n';
+    result.exitCode = -1;
+  }
+
+  result.output = out.str();
+  result.errors = err.str();
+  return result;
+}
+//-----------------------------------------------------------------------------------------------------------
+// isto sto i ./assembler, ali se asemblirani objekti cuvaju u kesu za kasnije linkovanje
+int32_t ToolchainServer::runAssembler(const std::vector<std::string>& arguments, std::ostream& out, std::ostream& err)
+{
+  asm_core::AssemblerCommand command = asm_core::parseAssemblerCommand(arguments);
+  const std::vector<asm_core::AssemblerJob>& jobs = command.jobs;
+
+  std::unique_ptr<asm_core::AssemblyCache> cache;
+  if(!command.cacheDirectory.empty())
+  {
+    cache = std::make_unique<asm_core::AssemblyCache>(command.cacheDirectory);
+  }
+
+  std::vector<asm_core::AssemblyTimes> times(jobs.size());
+  std::vector<std::string> errors(jobs.size());
+  uint32_t numThreads = command.numThreads == 0 ? std::thread::hardware_concurrency() : command.numThreads;
+  ThreadPool threadPool(std::max<uint32_t>(1, std::min<uint32_t>(numThreads, jobs.size())));
+  threadPool.parallelFor(jobs.size(), [&](uint32_t i)
+    {
+      const asm_core::AssemblerJob& job = jobs[i];
+      try
+      {
+        if(cache != nullptr) // pogodak je samo kopija fajla, objekat se parsira tek kada zatreba linkeru
+        {
+          asm_core::assembleFile(job.inputFilePath, job.outputFilePath, command.timing ? &times[i] : nullptr,
+                                 cache.get());
+          return;
+        }
+        auto data = std::make_shared<const lnk_core::LinkerInputData>(asm_core::assembleToLinkerInput(
+          job.inputFilePath, job.outputFilePath, command.timing ? &times[i] : nullptr));
+        FileStamp stamp;
+        if(ObjectCache::getFileStamp(job.outputFilePath, stamp))
+        {
+          objectCache.store(job.outputFilePath, stamp, std::move(data));
+        }
+      }
+      catch(const std::exception& e)
+      {
+        errors[i] = jobs.size() == 1 ? e.what() : job.inputFilePath + ": " + e.what();
+      }
+    });
+
+  bool hasErrors = false;
+  for(uint32_t i = 0; i < jobs.size(); ++i)
+  {
+    if(!errors[i].empty())
+    {
+      err << errors[i] << '\n';
+      hasErrors = true;
+    }
+    else if(command.timing)
+    {
+      asm_core::printAssemblyTimes(jobs[i].inputFilePath, times[i], out);
+    }
+  }
+
+  if(cache != nullptr)
+  {
+    asm_core::AssemblyCacheStatistics totalStatistics = cache->recordStatistics();
+    if(command.printCacheStatistics)
+    {
+      cache->printStatistics(totalStatistics, out);
+    }
+  }
+  return hasErrors ? -1 : 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+// isto sto i ./linker. Objektni fajlovi se uzimaju iz kesa; arhive i -incremental idu kroz citanje fajlova
+int32_t ToolchainServer::runLinker(const std::vector<std::string>& arguments, std::ostream& out)
+{
+  lnk_core::LinkerCommand command = lnk_core::parseLinkerCommand(arguments);
+  command.options.log = &out;
+
+  bool useCache = !command.options.incremental;
+  std::vector<lnk_core::LinkerInputData> inputData;
+  for(const std::string& inputFilePath : command.inputFilePaths)
+  {
+    if(!useCache || ArchiveFileProcessor::isArchive(inputFilePath))
+    {
+      useCache = false;
+      break;
+    }
+    inputData.push_back(*loadObject(inputFilePath)); // linker popunjava svoje podatke u kopiji
+  }
+
+  if(useCache)
+  {
+    lnk_core::Linker linker(command.placements, std::move(inputData), command.inputFilePaths, command.outputFilePath,
+                            command.options);
+    linker.performLinking();
+  }
+  else
+  {
+    lnk_core::Linker linker(command.placements, command.inputFilePaths, command.outputFilePath, command.options);
+    linker.performLinking();
+  }
+  return 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::shared_ptr<const lnk_core::LinkerInputData> ToolchainServer::loadObject(const std::string& filePath)
+{
+  std::shared_ptr<const lnk_core::LinkerInputData> data = objectCache.find(filePath);
+  if(data != nullptr)
+  {
+    return data;
+  }
+
+  // otisak pre citanja: ako se fajl izmeni tokom citanja, sledeci posao ga cita ponovo
+  FileStamp stamp;
+  bool hasStamp = ObjectCache::getFileStamp(filePath, stamp);
+  data = std::make_shared<const lnk_core::LinkerInputData>(ObjectFileProcessor::readFromFile(filePath));
+  if(hasStamp)
+  {
+    objectCache.store(filePath, stamp, data);
+  }
+  return data;
+}
+//-----------------------------------------------------------------------------------------------------------
+// budi accept i radne niti; accept na Linux-u se vraca sa greskom kada se socket zatvori za citanje
+void ToolchainServer::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    isStopping = true;
+  }
+  queueCondition.notify_all();
+  shutdown(listenFd, SHUT_RDWR);
+}
+
+} // namespace toolchaind_core
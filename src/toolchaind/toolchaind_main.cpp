@@ -0,0 +1,159 @@
+#include <toolchaind/toolchain_server.hpp>
+#include <toolchaind/toolchaind_protocol.hpp>
+
+#include <common/exceptions.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace common;
+using namespace toolchaind_core;
+
+namespace
+{
+
+const std::string USAGE =
+  "Greska! Ispravna sintaksa:\n"
+  "  ./toolchaind -server [-socket=putanja] [-threads=n]\n"
+  "  ./toolchaind [-socket=putanja] assembler|linker argumenti...\n"
+  "  ./toolchaind [-socket=putanja] -stop";
+
+bool startsWith(const std::string& argument, const std::string& prefix)
+{
+  return argument.compare(0, prefix.size(), prefix) == 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string toAbsolutePath(const std::string& filePath)
+{
+  return std::filesystem::absolute(filePath).lexically_normal().string();
+}
+//-----------------------------------------------------------------------------------------------------------
+// server ima svoj radni direktorijum, pa klijent salje apsolutne putanje: svi argumenti koji nisu opcije
+// (ulazi i izlaz posle -o) i putanje u -map=, -profile= i -cache=
+std::vector<std::string> resolvePaths(const std::vector<std::string>& arguments)
+{
+  std::vector<std::string> resolvedArguments;
+  for(const std::string& argument : arguments)
+  {
+    if(!argument.empty() && argument[0] != '-')
+    {
+      resolvedArguments.push_back(toAbsolutePath(argument));
+    }
+    else if(startsWith(argument, "-map=") && argument.size() > 5)
+    {
+      resolvedArguments.push_back("-map=" + toAbsolutePath(argument.substr(5)));
+    }
+    else if(startsWith(argument, "-profile=") && argument.size() > 9)
+    {
+      resolvedArguments.push_back("-profile=" + toAbsolutePath(argument.substr(9)));
+    }
+    else if(startsWith(argument, "-cache=") && argument.size() > 7)
+    {
+      resolvedArguments.push_back("-cache=" + toAbsolutePath(argument.substr(7)));
+    }
+    else
+    {
+      resolvedArguments.push_back(argument);
+    }
+  }
+  return resolvedArguments;
+}
+//-----------------------------------------------------------------------------------------------------------
+int runServer(const std::string& socketPath, uint32_t numWorkers)
+{
+  ToolchainServer server(socketPath, numWorkers);
+  std::cout << "Server slusa na " << socketPath << std::endl;
+  server.serve();
+  return 0;
+}
+//-----------------------------------------------------------------------------------------------------------
+int runClient(const std::string& socketPath, const std::vector<std::string>& request)
+{
+  int socketFd = connectToSocket(socketPath);
+  if(socketFd < 0)
+  {
+    throw RuntimeError("Server ne radi na socket-u " + socketPath + " (pokrece se sa ./toolchaind -server)!");
+  }
+
+  JobResult result;
+  try
+  {
+    writeRequest(socketFd, request);
+    result = readResult(socketFd);
+  }
+  catch(...)
+  {
+    close(socketFd);
+    throw;
+  }
+  close(socketFd);
+
+  std::cout << result.output << std::flush;
+  std::cerr << result.errors << std::flush;
+  return result.exitCode;
+}
+
+} // namespace
+
+// server drzi asembler i linker ucitane izmedju poslova, klijent prosledjuje komandnu liniju alata
+int main(int argc, char* argv[])
+{
+  try
+  {
+    std::string socketPath = getDefaultSocketPath();
+    bool serverMode = false;
+    uint32_t numWorkers = 0;
+    int i = 1;
+    for(; i < argc; ++i)
+    {
+      std::string argument = argv[i];
+      if(startsWith(argument, "-socket="))
+      {
+        socketPath = argument.substr(8);
+      }
+      else if(argument == "-server")
+      {
+        serverMode = true;
+      }
+      else if(startsWith(argument, "-threads="))
+      {
+        numWorkers = std::strtoul(argument.substr(9).c_str(), nullptr, 0);
+      }
+      else if(argument == "-stop")
+      {
+        return runClient(socketPath, {STOP_REQUEST});
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    if(serverMode)
+    {
+      if(i != argc)
+      {
+        throw RuntimeError(USAGE);
+      }
+      return runServer(socketPath, numWorkers == 0 ? std::thread::hardware_concurrency() : numWorkers);
+    }
+
+    if(i == argc || (argv[i] != ASSEMBLER_REQUEST && argv[i] != LINKER_REQUEST))
+    {
+      throw RuntimeError(USAGE);
+    }
+    std::vector<std::string> request = resolvePaths(std::vector<std::string>(argv + i + 1, argv + argc));
+    request.insert(request.begin(), argv[i]);
+    return runClient(socketPath, request);
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr << e.what() << '\n';
+    return -1;
+  }
+}
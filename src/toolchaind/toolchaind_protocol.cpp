@@ -0,0 +1,242 @@
+#include <toolchaind/toolchaind_protocol.hpp>
+
+#include <common/exceptions.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace common;
+
+namespace
+{
+constexpr uint32_t MAX_REQUEST_STRINGS = 1 << 16;
+constexpr uint32_t MAX_STRING_SIZE = 1 << 28; // ispis tabela linkera ume da bude velik
+
+sockaddr_un makeAddress(const std::string& socketPath)
+{
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if(socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+  {
+    throw RuntimeError("Neispravna putanja socket-a " + socketPath + "!");
+  }
+  std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+  return address;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string getErrnoMessage()
+{
+  return std::strerror(errno);
+}
+//-----------------------------------------------------------------------------------------------------------
+void writeBytes(int socketFd, const void* data, size_t size)
+{
+  const char* bytes = static_cast<const char*>(data);
+  while(size > 0)
+  {
+    ssize_t written = send(socketFd, bytes, size, MSG_NOSIGNAL); // prekinuta veza ne gasi proces signalom
+    if(written < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if(written <= 0)
+    {
+      throw RuntimeError("Greska pri slanju preko socket-a: " + getErrnoMessage());
+    }
+    bytes += written;
+    size -= written;
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+// false ako je veza zatvorena pre prvog bajta
+bool readBytes(int socketFd, void* data, size_t size)
+{
+  char* bytes = static_cast<char*>(data);
+  size_t totalRead = 0;
+  while(totalRead < size)
+  {
+    ssize_t numRead = recv(socketFd, bytes + totalRead, size - totalRead, 0);
+    if(numRead < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if(numRead == 0 && totalRead == 0)
+    {
+      return false;
+    }
+    if(numRead <= 0)
+    {
+      throw RuntimeError("Veza preko socket-a je prekinuta usred poruke!");
+    }
+    totalRead += numRead;
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+void readExactly(int socketFd, void* data, size_t size)
+{
+  if(!readBytes(socketFd, data, size))
+  {
+    throw RuntimeError("Veza preko socket-a je prekinuta usred poruke!");
+  }
+}
+//-----------------------------------------------------------------------------------------------------------
+void appendNumber(std::string& message, uint32_t number)
+{
+  message.append(reinterpret_cast<const char*>(&number), sizeof(number));
+}
+//-----------------------------------------------------------------------------------------------------------
+void appendString(std::string& message, const std::string& text)
+{
+  if(text.size() > MAX_STRING_SIZE)
+  {
+    throw RuntimeError("Poruka je prevelika za slanje preko socket-a!");
+  }
+  appendNumber(message, text.size());
+  message += text;
+}
+//-----------------------------------------------------------------------------------------------------------
+uint32_t readNumber(int socketFd)
+{
+  uint32_t number;
+  readExactly(socketFd, &number, sizeof(number));
+  return number;
+}
+//-----------------------------------------------------------------------------------------------------------
+std::string readString(int socketFd)
+{
+  uint32_t size = readNumber(socketFd);
+  if(size > MAX_STRING_SIZE)
+  {
+    throw RuntimeError("Neispravna poruka preko socket-a!");
+  }
+  std::string text(size, '\0');
+  readExactly(socketFd, text.data(), size);
+  return text;
+}
+
+} // namespace
+
+namespace toolchaind_core
+{
+
+std::string getDefaultSocketPath()
+{
+  const char* socketPath = std::getenv("TOOLCHAIND_SOCKET");
+  if(socketPath != nullptr && socketPath[0] != '\0')
+  {
+    return socketPath;
+  }
+  return "/tmp/toolchaind-" + std::to_string(getuid()) + ".sock";
+}
+//-----------------------------------------------------------------------------------------------------------
+int listenOnSocket(const std::string& socketPath)
+{
+  sockaddr_un address = makeAddress(socketPath);
+
+  // fajl na putanji je ili socket servera koji radi, ili ostatak servera koji je prekinut
+  struct stat fileStatus;
+  if(lstat(socketPath.c_str(), &fileStatus) == 0 && !S_ISSOCK(fileStatus.st_mode))
+  {
+    throw RuntimeError("Na putanji " + socketPath + " postoji fajl koji nije socket!");
+  }
+  int probeFd = connectToSocket(socketPath);
+  if(probeFd >= 0)
+  {
+    close(probeFd);
+    throw RuntimeError("Server vec radi na socket-u " + socketPath + "!");
+  }
+  unlink(socketPath.c_str());
+
+  int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if(listenFd < 0)
+  {
+    throw RuntimeError("Greska pri pravljenju socket-a: " + getErrnoMessage());
+  }
+  mode_t oldMask = umask(0077); // poslovi se izvrsavaju sa pravima servera, pa samo vlasnik sme da se poveze
+  int bindResult = bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+  umask(oldMask);
+  if(bindResult != 0 || listen(listenFd, SOMAXCONN) != 0)
+  {
+    std::string message = getErrnoMessage();
+    close(listenFd);
+    throw RuntimeError("Greska pri otvaranju socket-a " + socketPath + ": " + message);
+  }
+
+  return listenFd;
+}
+//-----------------------------------------------------------------------------------------------------------
+// -1 ako server ne radi na toj putanji
+int connectToSocket(const std::string& socketPath)
+{
+  sockaddr_un address = makeAddress(socketPath);
+  int socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if(socketFd < 0)
+  {
+    throw RuntimeError("Greska pri pravljenju socket-a: " + getErrnoMessage());
+  }
+  if(connect(socketFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+  {
+    close(socketFd);
+    return -1;
+  }
+  return socketFd;
+}
+//-----------------------------------------------------------------------------------------------------------
+void writeRequest(int socketFd, const std::vector<std::string>& request)
+{
+  std::string message;
+  appendNumber(message, request.size());
+  for(const std::string& text : request)
+  {
+    appendString(message, text);
+  }
+  writeBytes(socketFd, message.data(), message.size());
+}
+//-----------------------------------------------------------------------------------------------------------
+bool readRequest(int socketFd, std::vector<std::string>& request)
+{
+  uint32_t numStrings;
+  if(!readBytes(socketFd, &numStrings, sizeof(numStrings)))
+  {
+    return false;
+  }
+  if(numStrings == 0 || numStrings > MAX_REQUEST_STRINGS)
+  {
+    throw RuntimeError("Neispravan zahtev preko socket-a!");
+  }
+
+  request.clear();
+  request.reserve(numStrings);
+  for(uint32_t i = 0; i < numStrings; ++i)
+  {
+    request.push_back(readString(socketFd));
+  }
+  return true;
+}
+//-----------------------------------------------------------------------------------------------------------
+void writeResult(int socketFd, const JobResult& result)
+{
+  std::string message;
+  appendNumber(message, static_cast<uint32_t>(result.exitCode));
+  appendString(message, result.output);
+  appendString(message, result.errors);
+  writeBytes(socketFd, message.data(), message.size());
+}
+//-----------------------------------------------------------------------------------------------------------
+JobResult readResult(int socketFd)
+{
+  JobResult result;
+  result.exitCode = static_cast<int32_t>(readNumber(socketFd));
+  result.output = readString(socketFd);
+  result.errors = readString(socketFd);
+  return result;
+}
+
+} // namespace toolchaind_core
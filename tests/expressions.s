@@ -0,0 +1,35 @@
+# file: expressions.s
+# operandi kao izrazi: razlika simbola iz iste sekcije je konstanta, a simbol uvecan za konstantu
+# (i eksterni) dobija relokaciju, dok je konstanta vec upisana u rec koju linker prepravlja
+
+.extern table
+
+.global expr_start
+
+.section my_code
+expr_start:
+    ld $array + 8, %r1              # adresa treceg elementa
+    ld [%r1], %r1                   # 30
+    ld array + 4, %r2               # 20
+    ld $(arrayEnd - array) / 4, %r3 # broj elemenata: 4
+    ld $table + 8, %r4              # eksterni simbol uvecan za konstantu
+    ld [%r4], %r4                   # 0x33
+    ld arraySize, %r5               # 16
+    ld tableSecond, %r6
+    ld [%r6], %r6                   # 0x22
+    ld $-(3 * 2) + 10, %r7          # 4
+    st %r1, array + 12
+    ld array + 12, %r8              # 30
+
+    halt
+
+.section my_data
+array:
+.word 10, 20, 30, 40
+arrayEnd:
+arraySize:
+.word arrayEnd - array
+tableSecond:
+.word table + 4
+
+.end
@@ -0,0 +1,9 @@
+# file: expressions_table.s
+
+.global table
+
+.section my_table
+table:
+.word 0x11, 0x22, 0x33, 0x44
+
+.end
@@ -0,0 +1,12 @@
+ASSEMBLER=../assembler
+LINKER=../linker
+EMULATOR=../emulator
+
+# ocekivano: r1=0x1e r2=0x14 r3=0x4 r4=0x33 r5=0x10 r6=0x22 r7=0x4 r8=0x1e
+${ASSEMBLER} -o expressions.o expressions.s
+${ASSEMBLER} -o expressions_table.o expressions_table.s
+${LINKER} -hex \
+  -place=my_code@0x40000000 \
+  -o expressions.hex \
+  expressions.o expressions_table.o
+${EMULATOR} expressions.hex